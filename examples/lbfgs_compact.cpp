@@ -0,0 +1,85 @@
+#include "sOPT/bench/rosenbrock.hpp"
+#include "sOPT/sOPT.hpp"
+
+#include <chrono>
+#include <print>
+#include <random>
+
+using namespace sOPT;
+
+// Two-loop recursion vs compact (Byrd-Nocedal-Schnabel) L-BFGS on large n.
+template <typename Obj>
+void run(const char* name, const Obj& obj, ecref<vecXd> x0, Options opt) {
+    for (bool compact : {false, true}) {
+        opt.lbfgs.compact = compact;
+        const auto t0 = std::chrono::steady_clock::now();
+        auto res = lbfgs(obj, x0, opt);
+        const auto t1 = std::chrono::steady_clock::now();
+        std::println(
+            "{:<22} {:<9} iters = {:5}, f = {:.6e}, |g| = {:.3e}, time = {:.3f} s",
+            name,
+            compact ? "compact" : "two-loop",
+            res.iterations,
+            res.f,
+            res.grad_norm,
+            std::chrono::duration<f64>(t1 - t0).count()
+        );
+    }
+}
+
+// Compact vs two-loop H_k q on the same random history (ring wrapped twice).
+// Returns the relative difference ||r_compact - r_two_loop|| / ||r_two_loop||.
+template <typename T>
+f64 compact_mismatch(i32 n, i32 m) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<f64> u(-1.0, 1.0);
+    std::uniform_real_distribution<f64> d(1.0, 10.0);
+    detail::LBFGSHistory<T> two_loop;
+    detail::LBFGSHistory<T> compact;
+    two_loop.reset(n, m, false);
+    compact.reset(n, m, true);
+
+    vecXd s(n), y(n), q(n);
+    for (i32 k = 0; k < 2 * m + 3; k++) {
+        for (i32 i = 0; i < n; i++) {
+            s[i] = u(gen);
+            y[i] = d(gen) * s[i] + 0.1 * u(gen); // s^T y > 0
+        }
+        const f64 rho = 1.0 / s.dot(y);
+        two_loop.push(s, y, rho);
+        compact.push(s, y, rho);
+    }
+    for (i32 i = 0; i < n; i++) q[i] = u(gen);
+
+    // gamma = s^T y / y^T y of the newest pair
+    const f64 gamma = 1.0 / (two_loop.rho_at(m - 1) * two_loop.yy_newest());
+    vecXd r_two_loop(n), r_compact(n);
+    two_loop.apply_inverse(q, gamma, r_two_loop);
+    compact.apply_inverse(q, gamma, r_compact);
+    return (r_compact - r_two_loop).norm() / r_two_loop.norm();
+}
+
+int main() {
+    // f32 compact should agree with f32 two-loop up to the storage rounding
+    // (expected: f64 below 1e-10, f32 below 1e-5)
+    const f64 err64 = compact_mismatch<f64>(1000, 8);
+    const f64 err32 = compact_mismatch<f32>(1000, 8);
+    std::println(
+        "compact vs two-loop H q: f64 rel err = {:.3e}, f32 rel err = {:.3e}",
+        err64,
+        err32
+    );
+
+    Options opt;
+    opt.term.max_iters = 200;
+    opt.term.grad_tol = 1e-10;
+    opt.lbfgs.memory = 20;
+    opt.cache.h_slots = 0;
+
+    const i32 n = 1'000'000;
+
+    auto rosen = RosenbrockChained{};
+    run("Rosenbrock Chained", rosen, rosen.x0(n), opt);
+
+    return 0;
+}
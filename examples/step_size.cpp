@@ -191,5 +191,29 @@ int main() {
         print_sOPT_results(res);
         std::println();
     }
+
+    std::println("------------------------------------------------------------");
+
+    {
+        // constant low-fidelity model: the screen rejects every trial, so only the
+        // full re-check after the trials run out can flag the mismatches
+        struct ConstantLowFi : RosenbrockChained {
+            f64 func_lowfi(ecref<vecXd>) const { return 0.0; }
+        };
+        std::println(
+            "{} (Armijo LowFi Step, constant model): Rosenbrock Chained Objective, n = {}",
+            solver_name,
+            n
+        );
+        opt.ls.try_full_step = false;
+        auto res = newton(ConstantLowFi{}, x0, opt, ArmijoLowFi{});
+        print_sOPT_results(res);
+        std::println(
+            "Low-fi evals: {}, mismatches: {}",
+            res.lowfi_evals,
+            res.lowfi_mismatches
+        );
+        std::println();
+    }
     return 0;
 }
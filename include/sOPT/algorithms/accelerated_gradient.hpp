@@ -0,0 +1,351 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/step_size/armijo.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sOPT {
+namespace detail {
+// first trial step of the step strategy: the previous accepted step grown by
+// opt.agd.step_growth (FISTA-style backtracking keeps the estimate of 1/L)
+inline f64 agd_alpha0(i32 k, f64 alpha_prev, const Options& opt) {
+    if (k == 0 || opt.agd.step_growth == 0.0 || !finite_pos(alpha_prev)) {
+        return opt.ls.alpha0;
+    }
+    return std::min(alpha_prev * opt.agd.step_growth, opt.ls.alpha_max);
+}
+
+// Nesterov / FISTA. The solver state is the extrapolated point y_k: res.x, f and g
+// (and so the trace, callbacks and termination tests) refer to y_k.
+template <typename Obj, typename StepStrategy>
+Result nesterov_gradient(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const AcceleratedGradientOptions& agd = opt.agd;
+    vecXd g(n);      // gradient at y_k
+    vecXd x(n);      // x_k
+    vecXd x_next(n); // x_{k+1}, then y_{k+1}
+    vecXd p(n);      // -g, then x_{k+1} - x_k
+    for (vecXd* v : {&g, &x, &x_next, &p}) par_first_touch(*v, par);
+    f64 f = 0.0;   // f(y_k)
+    f64 f_x = 0.0; // f(x_k)
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    TerminationScales term_scales;
+
+    Options opt_ls = opt; // ls.alpha0 and ls.c1 for the step strategy
+    if (agd.ls_c1 > 0.0) opt_ls.ls.c1 = agd.ls_c1;
+
+    if (auto st = init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+    par_scale(1.0, res.x, x, par); // x_0 = y_0
+    f_x = f;
+
+    f64 t = 1.0; // FISTA t_k
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = par_norm(g, par);
+
+        if (auto st = pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        }
+
+        // x_{k+1} = y_k - alpha_k g(y_k)
+        par_scale(-1.0, g, p, par);
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = -gnorm * gnorm;
+        }
+        opt_ls.ls.alpha0 = agd_alpha0(k, alpha, opt);
+        const StepStatus step_status = run_step(
+            oracle,
+            opt_ls,
+            step_strategy,
+            res.x,
+            f,
+            g,
+            p,
+            alpha,
+            x_next,
+            f_next,
+            false // the unit-step probe would discard the carried step
+        );
+        if (step_status != StepStatus::accepted) {
+            res.status = to_status(step_status);
+            break;
+        }
+
+        // momentum: beta_k (x_{k+1} - x_k), reset on restart
+        par_lincomb(1.0, x_next, -1.0, x, p, par);
+        bool restart = false;
+        switch (agd.restart) {
+        case AccelRestart::off: break;
+        case AccelRestart::function: restart = f_next > f_x; break;
+        case AccelRestart::gradient: restart = par_dot(g, p, par) > 0.0; break;
+        }
+        f64 beta = 0.0;
+        if (restart) {
+            t = 1.0;
+        } else if (agd.momentum > 0.0) {
+            beta = agd.momentum;
+        } else {
+            const f64 t_next = 0.5 * (1.0 + std::sqrt(1.0 + 4.0 * t * t));
+            beta = (t - 1.0) / t_next;
+            t = t_next;
+        }
+
+        x.swap(x_next); // x = x_{k+1}, x_next free
+        f_x = f_next;
+        f64 f_y = f_x;
+        if (beta > 0.0) {
+            par_lincomb(1.0, x, beta, p, x_next, par); // y_{k+1}
+            if (eval_func(oracle, x_next, f_y) != EvalStatus::ok || !isfinite(f_y)) {
+                if (oracle.f_limit_reached()) {
+                    res.status = Status::max_evals;
+                    break;
+                }
+                beta = 0.0; // extrapolation left the domain: y_{k+1} = x_{k+1}
+                t = 1.0;
+            }
+        }
+        if (!(beta > 0.0)) {
+            par_scale(1.0, x, x_next, par);
+            f_y = f_x;
+        }
+
+        const f64 f_prev = f;
+        const f64 step_norm = par_distance(x_next, res.x, par); // ||y_{k+1} - y_k||
+        if (auto st = post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_y,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    }
+    finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+
+// Polyak heavy ball with a line search along p_k = -g_k + beta p_{k-1}
+template <typename Obj, typename StepStrategy>
+Result heavy_ball(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const AcceleratedGradientOptions& agd = opt.agd;
+    vecXd g(n); // gradient
+    vecXd p(n); // search direction (x_{k+1} - x_k = alpha_k p_k)
+    vecXd x_next(n);
+    for (vecXd* v : {&g, &p, &x_next}) par_first_touch(*v, par);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    TerminationScales term_scales;
+
+    Options opt_ls = opt; // ls.alpha0 and ls.c1 for the step strategy
+    if (agd.ls_c1 > 0.0) opt_ls.ls.c1 = agd.ls_c1;
+    const f64 beta = (agd.momentum > 0.0) ? agd.momentum : 0.9;
+
+    if (auto st = init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = par_norm(g, par);
+
+        if (auto st = pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        }
+
+        bool restart = (k == 0);
+        if (!restart) {
+            switch (agd.restart) {
+            case AccelRestart::off: break;
+            case AccelRestart::function: break; // rejected by options validation
+            case AccelRestart::gradient: restart = par_dot(g, p, par) > 0.0; break;
+            }
+        }
+        f64 gTp = -gnorm * gnorm;
+        if (!restart) {
+            par_lincomb(-1.0, g, beta, p, p, par);
+            gTp = par_dot(g, p, par);
+        }
+        if (restart || !(gTp < 0.0)) { // momentum reset or not a descent direction
+            par_scale(-1.0, g, p, par);
+            gTp = -gnorm * gnorm;
+        }
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = gTp;
+        }
+        opt_ls.ls.alpha0 = agd_alpha0(k, alpha, opt);
+        const StepStatus step_status = run_step(
+            oracle,
+            opt_ls,
+            step_strategy,
+            res.x,
+            f,
+            g,
+            p,
+            alpha,
+            x_next,
+            f_next,
+            false // the unit-step probe would discard the carried step
+        );
+        if (step_status != StepStatus::accepted) {
+            res.status = to_status(step_status);
+            break;
+        }
+
+        const f64 f_prev = f;
+        const f64 step_norm = alpha * par_norm(p, par);
+        if (auto st = post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    }
+    finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
+// Accelerated gradient (line-search)
+// ref: nesterov1983method, beck2009fast, polyak1964some, odonoghue2015adaptive
+//
+// opt.agd.method = nesterov (FISTA without the prox):
+//
+// \begin{aligned}
+// x_{k+1} &= y_k - \alpha_k \nabla f(y_k), \quad
+// t_{k+1} = \tfrac{1}{2}\big(1 + \sqrt{1 + 4 t_k^2}\big), \quad t_0 = 1 \\
+// y_{k+1} &= x_{k+1} + \beta_k (x_{k+1} - x_k), \quad
+// \beta_k = \frac{t_k - 1}{t_{k+1}} \ \text{(or opt.agd.momentum)}
+// \end{aligned}
+//
+// opt.agd.method = heavy_ball:
+//
+// \begin{aligned}
+// p_k &= -\nabla f(x_k) + \beta p_{k-1}, \quad x_{k+1} = x_k + \alpha_k p_k
+// \end{aligned}
+//
+// which is x_{k+1} = x_k - \alpha \nabla f(x_k) + \beta (x_k - x_{k-1}) for a constant
+// step. Adaptive restart (opt.agd.restart) drops the momentum for one step when
+// f(x_{k+1}) > f(x_k) (function, nesterov only: heavy_ball steps pass Armijo along a
+// descent direction, so f always decreases) or \nabla f^T (x_{k+1} - x_k) > 0
+// (gradient), with \nabla f at y_k (nesterov) or x_{k+1} (heavy_ball); nesterov also
+// resets t.
+// alpha_k comes from the step strategy with c1 = opt.agd.ls_c1 (1/2: the FISTA
+// backtracking test f(x_{k+1}) <= f(y_k) - \alpha/2 ||g||^2) starting from
+// alpha_{k-1} opt.agd.step_growth; opt.ls.try_full_step is ignored. nesterov
+// reports y_k (the point where g is evaluated) in res.x, the trace and callbacks,
+// and evaluates f(y_{k+1}) once per iteration.
+template <typename Obj, typename StepStrategy>
+Result accelerated_gradient(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    if (opt.agd.method == AccelMethod::heavy_ball) {
+        return detail::heavy_ball(obj, x0, opt, step_strategy, on_iter, should_stop);
+    }
+    return detail::nesterov_gradient(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
+
+// overload (default to Armijo)
+template <typename Obj>
+Result accelerated_gradient(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return accelerated_gradient(obj, x0, opt, Armijo{}, on_iter, should_stop);
+}
+
+} // namespace sOPT
@@ -2,7 +2,16 @@
 
 #include "sOPT/algorithms/bfgs.hpp"
 #include "sOPT/algorithms/lbfgs.hpp"
+#include "sOPT/algorithms/nonlinear_cg.hpp"
 #include "sOPT/algorithms/gradient_descent.hpp"
+#include "sOPT/algorithms/accelerated_gradient.hpp"
+#include "sOPT/algorithms/anderson.hpp"
 #include "sOPT/algorithms/newton.hpp"
+#include "sOPT/algorithms/newton_cg.hpp"
 #include "sOPT/algorithms/dfp.hpp"
-#include "sOPT/algorithms/sr1.hpp"
\ No newline at end of file
+#include "sOPT/algorithms/sr1.hpp"
+#include "sOPT/algorithms/gauss_newton.hpp"
+#include "sOPT/algorithms/gauss_newton_cg.hpp"
+#include "sOPT/algorithms/levenberg_marquardt.hpp"
+#include "sOPT/algorithms/newton_krylov.hpp"
+#include "sOPT/algorithms/broyden.hpp"
\ No newline at end of file
@@ -0,0 +1,325 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/anderson_history.hpp"
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/step_size/armijo.hpp"
+#include "sOPT/step_size/spectral.hpp"
+
+namespace sOPT {
+namespace detail {
+
+template <typename Obj, typename StepStrategy>
+Result anderson_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const AndersonOptions& aa = opt.anderson;
+    vecXd g(n);      // gradient (residual of G(x) = x - beta g, up to -beta)
+    vecXd p(n);      // -g, or the mixed step x_{k+1} - x_k
+    vecXd dg(n);     // g_k, then g_{k+1} - g_k
+    vecXd x_next(n);
+    for (vecXd* v : {&g, &p, &dg, &x_next}) par_first_touch(*v, par);
+    AndersonHistory hist;
+    hist.reset(n, aa.memory, par);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    f64 beta = 0.0; // step of the last base iteration, G(x) = x - beta g
+    TerminationScales term_scales;
+
+    if (auto st = init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = par_norm(g, par);
+
+        if (auto st = pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        }
+
+        // mixed point x + beta r - (dX + beta dR) gamma with r = g and -beta
+        bool mixed = false;
+        if (hist.size() > 0 && hist.solve(g, aa.regularization, par)) {
+            hist.mix(res.x, g, -beta, x_next, par);
+            const EvalStatus st = eval_func(oracle, x_next, f_next);
+            if (st == EvalStatus::max_evals) {
+                res.status = Status::max_evals;
+                break;
+            }
+            // sufficient decrease of the base step: f - c1 beta ||g||^2
+            mixed = st == EvalStatus::ok
+                && (!aa.safeguard || f_next <= f - opt.ls.c1 * beta * gnorm * gnorm);
+        }
+
+        IterDiagnostics diag;
+        if (mixed) {
+            par_lincomb(1.0, x_next, -1.0, res.x, p, par);
+            if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+                diag.gTp = par_dot(g, p, par);
+            }
+        } else { // base iteration: one gradient_descent step
+            par_scale(-1.0, g, p, par);
+            if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+                diag.gTp = -gnorm * gnorm;
+            }
+            const StepStatus step_status = run_step(
+                oracle,
+                opt,
+                step_strategy,
+                res.x,
+                f,
+                g,
+                p,
+                alpha,
+                x_next,
+                f_next
+            );
+            if (step_status != StepStatus::accepted) {
+                res.status = to_status(step_status);
+                break;
+            }
+            beta = alpha;
+            par_scale(alpha, p, p, par); // x_{k+1} - x_k
+        }
+
+        par_scale(1.0, g, dg, par);
+        const f64 f_prev = f;
+        const f64 step_norm = par_norm(p, par);
+        if (auto st = post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                mixed ? 1.0 : beta,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+
+        par_lincomb(1.0, g, -1.0, dg, dg, par);
+        hist.push(p, dg, par);
+        hist.limit_condition(aa.cond_max, par);
+    }
+    finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+
+template <typename Obj>
+Result anderson_fixed_point_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const AndersonOptions& aa = opt.anderson;
+    const f64 beta = aa.mixing;
+    vecXd F(n);  // residual G(x) - x
+    vecXd dx(n); // x_{k+1} - x_k
+    vecXd dF(n); // F_k, then F_{k+1} - F_k
+    vecXd x_next(n);
+    for (vecXd* v : {&F, &dx, &dF, &x_next}) par_first_touch(*v, par);
+    AndersonHistory hist;
+    hist.reset(n, aa.memory, par);
+    f64 f = 0.0; // 1/2 ||F||^2
+    f64 f_next = 0.0;
+    TerminationScales term_scales;
+
+    if (auto st = init_equation_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            F,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        finalize_common(res, oracle, f, F.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 Fnorm = par_norm(F, par);
+
+        if (auto st = pre_step_checks_equation(f, Fnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        }
+
+        bool mixed = false;
+        if (hist.size() > 0 && hist.solve(F, aa.regularization, par)) {
+            hist.mix(res.x, F, beta, x_next, par);
+            const EvalStatus st = eval_func(oracle, x_next, f_next);
+            if (st == EvalStatus::max_evals) {
+                res.status = Status::max_evals;
+                break;
+            }
+            mixed = st == EvalStatus::ok && (!aa.safeguard || f_next <= f);
+        }
+        if (!mixed) { // base iteration x + beta F(x)
+            par_lincomb(1.0, res.x, beta, F, x_next, par);
+            const EvalStatus st = eval_func(oracle, x_next, f_next);
+            if (st != EvalStatus::ok) {
+                res.status = to_status(st);
+                break;
+            }
+        }
+
+        par_lincomb(1.0, x_next, -1.0, res.x, dx, par);
+        par_scale(1.0, F, dF, par);
+        IterDiagnostics diag;
+        const f64 f_prev = f;
+        const f64 step_norm = par_norm(dx, par);
+        if (auto st = post_accept_equation_common(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                F,
+                x_next,
+                f_next,
+                f_prev,
+                mixed ? 1.0 : beta,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+
+        par_lincomb(1.0, F, -1.0, dF, dF, par);
+        hist.push(dx, dF, par);
+        hist.limit_condition(aa.cond_max, par);
+    }
+    finalize_common(res, oracle, f, F.norm());
+    return res;
+}
+} // namespace detail
+
+// Anderson acceleration (type-II, safeguarded) of gradient descent
+// ref: anderson1965iterative, walker2011anderson, scieur2016regularized
+//
+// Base iteration: the gradient_descent step x_k - \beta g_k, i.e. the fixed-point
+// map G(x) = x - \beta \nabla f(x) with \beta the last step of the step strategy.
+// With m_k = min(m, k) stored differences
+// \Delta X = [x_{i+1} - x_i], \Delta G = [g_{i+1} - g_i]:
+//
+// \begin{aligned}
+// \gamma_k &= \arg\min_\gamma \|g_k - \Delta G \gamma\|^2
+//             + \lambda \|\gamma\|^2, \quad
+// \lambda = \mathtt{regularization}\, \|\Delta G\|_F^2 \\
+// \tilde{x}_{k+1} &= x_k - \beta g_k - (\Delta X - \beta \Delta G) \gamma_k
+// \end{aligned}
+//
+// (m = opt.anderson.memory). The mixed point is accepted if
+// f(\tilde{x}_{k+1}) \le f_k - c_1 \beta \|g_k\|^2 (opt.anderson.safeguard, c_1 =
+// opt.ls.c1); otherwise the iteration is a plain gradient_descent step (one f
+// evaluation lost). The history is a ring of \Delta X and an incrementally updated
+// thin QR of \Delta G (detail::AndersonHistory): 2 m n doubles and O(m n) work per
+// iteration. Pairs are dropped oldest first while cond(R) > opt.anderson.cond_max.
+template <typename Obj, typename StepStrategy>
+Result anderson(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    static_assert(
+        !is_step_rule_v<StepStrategy>,
+        "anderson: BarzilaiBorwein / AdaptiveLipschitz are gradient_descent-only"
+    );
+    return detail::anderson_impl(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
+
+// overload (default to Armijo)
+template <typename Obj>
+Result anderson(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return anderson(obj, x0, opt, Armijo{}, on_iter, should_stop);
+}
+
+// Anderson acceleration of the fixed-point iteration x_{k+1} = x_k + \beta F(x_k)
+// for F(x) = G(x) - x (residual of a square is_least_squares_v objective):
+//
+// \begin{aligned}
+// \gamma_k &= \arg\min_\gamma \|F_k - \Delta F \gamma\|^2 + \lambda \|\gamma\|^2 \\
+// x_{k+1} &= x_k + \beta F_k - (\Delta X + \beta \Delta F) \gamma_k
+// \end{aligned}
+//
+// \beta = opt.anderson.mixing (1: x_{k+1} = G(x_k) without history). With
+// opt.anderson.safeguard the mixed point must not increase ||F||; otherwise the
+// base step x_k + \beta F_k is taken. f = 1/2 ||F||^2 and termination are those of
+// the other nonlinear-equation solvers (opt.nleq.res_tol).
+template <typename Obj>
+Result anderson_fixed_point(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    static_assert(
+        is_least_squares_v<Obj>,
+        "anderson_fixed_point: Obj needs residual(x, F) and num_residuals()"
+    );
+    return detail::anderson_fixed_point_impl(obj, x0, opt, on_iter, should_stop);
+}
+
+} // namespace sOPT
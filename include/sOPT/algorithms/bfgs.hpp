@@ -1,6 +1,8 @@
 #pragma once
 
+#include "sOPT/algorithms/detail/packed_sym.hpp"
 #include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/algorithms/detail/trial_pairs.hpp"
 #include "sOPT/core/callback.hpp"
 #include "sOPT/core/options.hpp"
 #include "sOPT/core/result.hpp"
@@ -53,9 +55,31 @@ Result bfgs(
     f64 alpha = 0.0;
     f64 last_ys = qNaN<f64>;
     f64 last_ys_cos = qNaN<f64>;
-    matXd B(n, n);
+    detail::PackedSym B(n); // packed lower triangle
     detail::TerminationScales term_scales;
-    B.setIdentity();
+    B.set_identity();
+
+    // line-search trial pairs (opt.qn.harvest_pairs > 0)
+    const bool harvest = opt.qn.harvest_pairs > 0;
+    bool have_prev = false; // s_old/g_old hold the previous step
+    vecXd s_old, g_old;     // s_{k-1}, g_{k-1}
+    vecXd s_trial, y_trial; // trial pair scratch
+    if (harvest) {
+        s_old.resize(n);
+        g_old.resize(n);
+        s_trial.resize(n);
+        y_trial.resize(n);
+    }
+
+    // inverse-BFGS update in symmetric form (one pass over packed B):
+    // B += coeff s s^T - rho (B y s^T + s y^T B)
+    auto update = [&](ecref<vecXd> s_u, ecref<vecXd> y_u, f64 ys_u) {
+        const f64 rho = 1.0 / ys_u;
+        B.multiply(y_u, By);
+        const f64 yBy = y_u.dot(By);
+        const f64 coeff = (1.0 + rho * yBy) * rho;
+        B.rank2_update(coeff, s_u, -rho, By, 0.0);
+    };
 
     if (auto st = detail::init_common( // sets x, f, and g in a first pass
             oracle,
@@ -81,9 +105,9 @@ Result bfgs(
             break;
         }
 
-        p.noalias() = -(B * g);
+        B.multiply(g, p, -1.0);
         if (g.dot(p) >= 0.0) { // ensure p is descending
-            B.setIdentity();
+            B.set_identity();
             p.noalias() = -g;
         }
 
@@ -119,6 +143,10 @@ Result bfgs(
         const f64 f_prev = f;
 
         if (!step_converged) {
+            if (harvest) { // keep the previous pair as the trial-pair anchor
+                s.swap(s_old);
+                g_prev.swap(g_old);
+            }
             // save secant pair data before x/g are updated
             s.noalias() = x_next - res.x;
             g_prev = g;
@@ -161,18 +189,26 @@ Result bfgs(
         
         // BFGS curvature condition y^T * s = s^T * y > 0
         if (isfinite(ys) && ys > tol_max * s.squaredNorm()) {
-            const f64 rho = 1.0 / ys;
-            By.noalias() = B.selfadjointView<eLo>() * y;
-            const f64 yBy = y.dot(By);
-            const f64 coeff = (1.0 + rho * yBy) * rho;
-            // inverse-BFGS update in symmetric form
-            B.selfadjointView<eLo>().rankUpdate(s, coeff); // B += coeff * s s^T
-            B.noalias() -= rho * (By * s.transpose());
-            B.noalias() -= rho * (s * By.transpose());
-            B = B.selfadjointView<eLo>(); // re-symmetrize
+            if (harvest && have_prev) { // older than (s, y): applied first
+                res.harvested_pairs += detail::harvest_trial_pairs(
+                    oracle,
+                    opt,
+                    alpha,
+                    p,
+                    s,
+                    s_old,
+                    g_old,
+                    tol_max,
+                    s_trial,
+                    y_trial,
+                    update
+                );
+            }
+            update(s, y, ys);
         } else {
             // skip update if curvature is bad (keeps B SPD-ish)
         }
+        have_prev = true;
 
     } // end iterations
 
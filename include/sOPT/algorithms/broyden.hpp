@@ -0,0 +1,265 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/step_size/armijo.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace sOPT {
+// Limited-memory Broyden ("good" update, line-search) for F(x) = 0
+// ref: kelley1995iterative pp.113-133, nocedal2006numerical pp.279-281
+//
+// \begin{aligned}
+// p_k &= -H_k F_k, \quad x_{k+1} = x_k + \alpha_k p_k \\
+// H_{k+1} &= H_k + \frac{(s_k - H_k y_k)\, s_k^T H_k}{s_k^T H_k y_k},
+// \quad s_k = x_{k+1} - x_k,\ y_k = F_{k+1} - F_k
+// \end{aligned}
+//
+// H_k ~ J_k^{-1} is kept as H_0 + \sum_i a_i b_i^T with
+// a_i = (s_i - H_i y_i) / (s_i^T H_i y_i) and b_i = H_i^T s_i: two n-vectors per
+// update, O(n m) per apply, and one residual per iteration (no Jacobian, no
+// products). H_0 = h_0 I, h_0 = 1 until the first pair, then
+// h_0 = s^T y / y^T y (the secant scalar, of either sign) from the pair that starts
+// each history. After opt.nleq.broyden_memory updates the history restarts with the
+// newest pair; with memory 0 every step is -h_0 F_k.
+//
+// Globalization: the step strategy runs on \phi = 1/2 ||F||^2 with the model slope
+// F_k^T B_k p_k = -||F_k||^2 (B_k = H_k^{-1}) in place of F_k^T J_k p_k, i.e.
+// Armijo asks for ||F_{k+1}||^2 <= (1 - 2 c_1 \alpha) ||F_k||^2. If p_k is not a
+// descent direction for \phi, the line search fails; a non-empty history is then
+// dropped and the iteration retried with p_k = -h_0 F_k, and if that fails too, once
+// more with h_0 <- -h_0 (so either sign of F works, x - G(x) or G(x) - x). A scaled
+// identity H_0 suits systems with J ~ c I (fixed-point form, or preconditioned F);
+// for ill-conditioned J prefer newton_krylov.
+namespace detail {
+
+struct BroydenHistory {
+    matXd A; // a_i = (s_i - H_i y_i) / (s_i^T H_i y_i)
+    matXd B; // b_i = H_i^T s_i
+    i32 size = 0;
+    f64 h0 = 1.0; // H_0 = h0 I
+
+    void reset(i32 n, i32 m, const ParallelOptions& par) {
+        A.resize(n, m);
+        B.resize(n, m);
+        par_first_touch(A.data(), n, m, par);
+        par_first_touch(B.data(), n, m, par);
+        size = 0;
+        h0 = 1.0;
+    }
+    i32 capacity() const { return static_cast<i32>(A.cols()); }
+
+    // out = H v = h0 v + sum_i a_i (b_i^T v)
+    void apply(ecref<vecXd> v, eref<vecXd> out, const ParallelOptions& par) const {
+        par_scale(h0, v, out, par);
+        for (i32 i = 0; i < size; i++) {
+            par_axpy(par_dot(B.col(i), v, par), A.col(i), out, par);
+        }
+    }
+    // out = H^T v = h0 v + sum_i b_i (a_i^T v)
+    void apply_t(ecref<vecXd> v, eref<vecXd> out, const ParallelOptions& par) const {
+        par_scale(h0, v, out, par);
+        for (i32 i = 0; i < size; i++) {
+            par_axpy(par_dot(A.col(i), v, par), B.col(i), out, par);
+        }
+    }
+
+    // H <- H + (s - H y) s^T H / (s^T H y); Hy is scratch. When full, restarts from
+    // H_0 rescaled by the new pair. Returns false (history cleared, pair dropped) if
+    // s^T H y ~ 0.
+    bool push(
+        ecref<vecXd> s,
+        ecref<vecXd> y,
+        eref<vecXd> Hy,
+        const ParallelOptions& par
+    ) {
+        if (size == capacity()) size = 0; // restart
+        if (size == 0) { // H_0 = (s^T y / y^T y) I from the newest pair
+            const f64 h = par_dot(s, y, par) / par_squared_norm(y, par);
+            if (isfinite(h) && h != 0.0) h0 = h;
+        }
+        if (capacity() == 0) return true;
+        apply(y, Hy, par);
+        apply_t(s, B.col(size), par);
+        const f64 sHy = par_dot(s, Hy, par);
+        const f64 scale = par_norm(s, par) * par_norm(Hy, par);
+        if (!(std::abs(sHy) > std::sqrt(std::numeric_limits<f64>::epsilon()) * scale)) {
+            size = 0;
+            return false;
+        }
+        par_lincomb(1.0 / sHy, s, -1.0 / sHy, Hy, A.col(size), par);
+        ++size;
+        return true;
+    }
+};
+
+template <typename Obj, typename StepStrategy>
+Result broyden_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    vecXd F(n);      // residual
+    vecXd F_prev(n); // residual at x_k, for y_k
+    vecXd p(n);      // Broyden direction
+    vecXd gp(n);     // merit slope carrier, gp^T p = -||F||^2
+    vecXd s(n);      // x_{k+1} - x_k
+    vecXd y(n);      // F_{k+1} - F_k
+    vecXd Hy(n);     // update scratch
+    vecXd x_next(n);
+    for (vecXd* v : {&F, &F_prev, &p, &gp, &s, &y, &Hy, &x_next}) {
+        detail::par_first_touch(*v, par);
+    }
+    detail::BroydenHistory hist;
+    hist.reset(n, opt.nleq.broyden_memory, par);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    detail::TerminationScales term_scales;
+
+    if (auto st = detail::init_equation_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            F,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, F.norm());
+        return res;
+    }
+
+    bool flipped = false; // h0 sign already retried since the last accepted step
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 Fnorm = detail::par_norm(F, par);
+
+        if (auto st = detail::pre_step_checks_equation(f, Fnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        hist.apply(F, p, par);
+        detail::par_scale(-1.0, p, p, par);
+        const f64 slope = -Fnorm * Fnorm; // F^T B p
+        const f64 pp = detail::par_squared_norm(p, par);
+        if (!(pp > 0.0) || !isfinite(pp)) {
+            res.status = Status::linear_solve_failed;
+            break;
+        }
+        detail::par_scale(slope / pp, p, gp, par);
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = slope;
+        }
+
+        const detail::StepStatus step_status = detail::run_step(
+            oracle,
+            opt,
+            step_strategy,
+            res.x,
+            f,
+            gp,
+            p,
+            alpha,
+            x_next,
+            f_next
+        );
+        if (step_status == detail::StepStatus::line_search_failed) {
+            if (hist.size > 0) {
+                hist.size = 0; // retry from H_0 = h0 I
+                continue;
+            }
+            if (!flipped) { // H_0 = h0 I points uphill: J ~ -c I, retry with -h0
+                hist.h0 = -hist.h0;
+                flipped = true;
+                continue;
+            }
+        }
+        if (step_status != detail::StepStatus::accepted) {
+            res.status = detail::to_status(step_status);
+            break;
+        }
+
+        flipped = false;
+        detail::par_lincomb(1.0, x_next, -1.0, res.x, s, par);
+        detail::par_scale(1.0, F, F_prev, par);
+
+        const f64 f_prev = f;
+        const f64 step_norm = detail::par_norm(s, par);
+        if (auto st = detail::post_accept_equation_common(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                F,
+                x_next,
+                f_next,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+
+        detail::par_lincomb(1.0, F, -1.0, F_prev, y, par);
+        hist.push(s, y, Hy, par);
+    } // end iteration
+    detail::finalize_common(res, oracle, f, F.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj, typename StepStrategy>
+Result broyden(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    static_assert(
+        is_least_squares_v<Obj>,
+        "broyden: Obj needs residual(x, F) and num_residuals()"
+    );
+    return detail::broyden_impl(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
+
+// overload default Armijo
+template <typename Obj>
+Result broyden(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return broyden(obj, x0, opt, Armijo{}, on_iter, should_stop);
+}
+
+} // namespace sOPT
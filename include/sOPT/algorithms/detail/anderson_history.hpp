@@ -0,0 +1,221 @@
+#pragma once
+
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/typedefs.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <Eigen/QR>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sOPT::detail {
+
+// Anderson (type-II) mixing history {(dx_i, dr_i)}, logical index i = 0 oldest,
+// dx_i = x_{i+1} - x_i and dr_i = r_{i+1} - r_i for the residual r of the
+// fixed-point map G(x) = x + beta r(x).
+// ref: walker2011anderson
+//
+// \begin{aligned}
+// \gamma_k &= \arg\min_\gamma \|r_k - \Delta R \gamma\|^2 + \lambda \|\gamma\|^2 \\
+// x_{k+1} &= x_k + \beta r_k - (\Delta X + \beta \Delta R) \gamma_k
+// \end{aligned}
+//
+// dX is an n x m ring (logical index i in column slot(i)). dR is kept only as its
+// thin QR factors dR = Q R, Q n x m with orthonormal columns in logical order and
+// R m x m upper triangular; nothing is ever refactored. push() appends a column by
+// classical Gram-Schmidt with one reorthogonalization; pop_oldest() deletes the
+// first column of R and restores the triangle with Givens rotations, applied to
+// the columns of Q (qrdelete). Both cost O(m n), and storage is 2 m n doubles.
+struct AndersonHistory {
+    matXd dX; // ring of x_{i+1} - x_i
+    matXd Q;  // orthonormal basis of span(dR), logical order
+    matXd R;  // upper factor, logical order
+    vecXd h;  // m-sized workspace: projections, then Q^T r
+    vecXd gamma;
+
+    void reset(i32 n, i32 m, const ParallelOptions& par) {
+        m = std::max(m, 0);
+        dX.resize(n, m);
+        Q.resize(n, m);
+        par_first_touch(dX.data(), n, m, par);
+        par_first_touch(Q.data(), n, m, par);
+        R.setZero(m, m);
+        h.resize(m);
+        gamma.resize(m);
+        rot_c_.resize(m);
+        rot_s_.resize(m);
+        head_ = 0;
+        len_ = 0;
+    }
+    void clear() {
+        head_ = 0;
+        len_ = 0;
+    }
+
+    i32 size() const { return len_; }
+    i32 capacity() const { return static_cast<i32>(dX.cols()); }
+
+    // column of dX holding logical index i
+    i32 slot(i32 i) const {
+        const i32 j = head_ + i;
+        return (j >= capacity()) ? j - capacity() : j;
+    }
+
+    // Appends (dx, dr), dropping the oldest pair when full. dr is overwritten (it
+    // becomes the new column of Q). Returns false (history unchanged apart from
+    // the drop) if dr is numerically in the span of the stored differences.
+    bool push(ecref<vecXd> dx, eref<vecXd> dr, const ParallelOptions& par) {
+        const i32 m = capacity();
+        if (m == 0) return false;
+        if (len_ == m) pop_oldest(par);
+        const i32 L = len_;
+        const f64 dr_norm = par_norm(dr, par);
+        if (!(dr_norm > 0.0) || !isfinite(dr_norm)) return false;
+
+        R.col(L).setZero();
+        for (i32 pass = 0; pass < 2; pass++) { // CGS2
+            project_(dr, L, par);
+            if (par_enabled(par, dr.size())) {
+                for (i32 i = 0; i < L; i++) par_axpy(-h(i), Q.col(i), dr, par);
+            } else {
+                dr.noalias() -= Q.leftCols(L) * h.head(L);
+            }
+            R.col(L).head(L) += h.head(L);
+        }
+        const f64 rnn = par_norm(dr, par);
+        if (!(rnn > std::numeric_limits<f64>::epsilon() * dr_norm)) return false;
+        par_scale(1.0 / rnn, dr, Q.col(L), par);
+        R(L, L) = rnn;
+        par_scale(1.0, dx, dX.col(slot(L)), par);
+        ++len_;
+        return true;
+    }
+
+    // drops the oldest pair: R <- G R[:, 1:], Q <- Q G^T, last column discarded
+    void pop_oldest(const ParallelOptions& par) {
+        if (len_ == 0) return;
+        const i32 L = len_;
+        for (i32 j = 0; j + 1 < L; j++) R.col(j).head(L) = R.col(j + 1).head(L);
+        for (i32 j = 0; j + 1 < L; j++) { // zero the subdiagonal R(j + 1, j)
+            const f64 a = R(j, j);
+            const f64 b = R(j + 1, j);
+            const f64 r = std::hypot(a, b);
+            const f64 c = (r > 0.0) ? a / r : 1.0;
+            const f64 s = (r > 0.0) ? b / r : 0.0;
+            for (i32 col = j; col + 1 < L; col++) {
+                const f64 rj = R(j, col);
+                R(j, col) = c * rj + s * R(j + 1, col);
+                R(j + 1, col) = -s * rj + c * R(j + 1, col);
+            }
+            R(j + 1, j) = 0.0;
+            rot_c_(j) = c;
+            rot_s_(j) = s;
+        }
+        rotate_q_(L - 1, par);
+        R.col(L - 1).setZero();
+        R.row(L - 1).setZero();
+        head_ = (head_ + 1 == capacity()) ? 0 : head_ + 1;
+        --len_;
+    }
+
+    // drops the oldest pairs while the diagonal estimate of cond(R) exceeds cond_max
+    void limit_condition(f64 cond_max, const ParallelOptions& par) {
+        while (len_ > 1) {
+            const auto d = R.diagonal().head(len_).cwiseAbs();
+            if (!(d.maxCoeff() > cond_max * d.minCoeff())) break;
+            pop_oldest(par);
+        }
+    }
+
+    // gamma = argmin ||r - dR gamma||^2 + lambda ||gamma||^2 with
+    // lambda = reg ||dR||_F^2 = reg ||R||_F^2 (scale invariant)
+    bool solve(ecref<vecXd> r, f64 reg, const ParallelOptions& par) {
+        const i32 L = len_;
+        if (L == 0) return false;
+        project_(r, L, par); // c = Q^T r
+        const auto RL = R.topLeftCorner(L, L);
+        const f64 lambda = reg * RL.squaredNorm();
+        if (lambda > 0.0) { // min ||[R; sqrt(lambda) I] gamma - [c; 0]||
+            Rs_.setZero(2 * L, L);
+            Rs_.topRows(L) = RL.triangularView<eig::Upper>();
+            Rs_.bottomRows(L).diagonal().setConstant(std::sqrt(lambda));
+            cs_.setZero(2 * L);
+            cs_.head(L) = h.head(L);
+            gamma.head(L) = Rs_.householderQr().solve(cs_);
+        } else {
+            gamma.head(L) = RL.triangularView<eig::Upper>().solve(h.head(L));
+        }
+        return gamma.head(L).allFinite();
+    }
+
+    // out = x + beta r - (dX + beta dR) gamma, gamma from the last solve()
+    void mix(
+        ecref<vecXd> x,
+        ecref<vecXd> r,
+        f64 beta,
+        eref<vecXd> out,
+        const ParallelOptions& par
+    ) {
+        const i32 L = len_;
+        par_lincomb(1.0, x, beta, r, out, par);
+        h.head(L) = R.topLeftCorner(L, L).triangularView<eig::Upper>() * gamma.head(L);
+        for (i32 i = 0; i < L; i++) {
+            par_axpy(-gamma(i), dX.col(slot(i)), out, par);
+            par_axpy(-beta * h(i), Q.col(i), out, par); // dR gamma = Q (R gamma)
+        }
+    }
+
+  private:
+    // h = Q[:, :L]^T v (one GEMV on the serial path)
+    void project_(ecref<vecXd> v, i32 L, const ParallelOptions& par) {
+        if (par_enabled(par, v.size())) {
+            for (i32 i = 0; i < L; i++) h(i) = par_dot(Q.col(i), v, par);
+        } else {
+            h.head(L).noalias() = Q.leftCols(L).transpose() * v;
+        }
+    }
+
+    // [q_j, q_{j+1}] <- [c_j q_j + s_j q_{j+1}, -s_j q_j + c_j q_{j+1}] for
+    // j = 0..count-1 in order, applied block by block so Q is streamed once.
+    // Entries that underflow are flushed to zero: components of converged modes
+    // shrink with every deletion, and subnormal arithmetic would slow every later
+    // pass over Q by orders of magnitude.
+    void rotate_q_(i32 count, const ParallelOptions& par) {
+        constexpr i64 block = 512;
+        const i64 n = Q.rows();
+        auto rotate = [&](i64 i0, i64 len) {
+            constexpr f64 tiny = std::numeric_limits<f64>::min();
+            for (i64 b0 = i0; b0 < i0 + len; b0 += block) {
+                const i64 b1 = std::min(b0 + block, i0 + len);
+                for (i32 j = 0; j < count; j++) {
+                    const f64 c = rot_c_(j);
+                    const f64 s = rot_s_(j);
+                    f64* a = Q.col(j).data();
+                    f64* b = Q.col(j + 1).data();
+                    for (i64 i = b0; i < b1; i++) {
+                        const f64 qa = c * a[i] + s * b[i];
+                        const f64 qb = -s * a[i] + c * b[i];
+                        a[i] = (std::abs(qa) < tiny) ? 0.0 : qa;
+                        b[i] = (std::abs(qb) < tiny) ? 0.0 : qb;
+                    }
+                }
+            }
+        };
+        if (par_enabled(par, n)) {
+            par_for_chunks(n, par, [&](i64 i0, i64 len, i64) { rotate(i0, len); });
+        } else {
+            rotate(0, n);
+        }
+    }
+
+    i32 head_ = 0; // column of dX holding the oldest pair
+    i32 len_ = 0;
+    matXd Rs_; // regularized solve workspace
+    vecXd cs_;
+    vecXd rot_c_; // pop_oldest Givens rotations
+    vecXd rot_s_;
+};
+
+} // namespace sOPT::detail
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace sOPT::detail {
+// Restarted GMRES on J p = -F from p = 0, J only through oracle.try_jvp
+// ref: saad1986gmres, kelley1995iterative pp.37-47
+//
+// \begin{aligned}
+// J V_j &= V_{j+1} \bar{H}_j \quad \text{(Arnoldi, modified Gram-Schmidt)} \\
+// y_j &= \arg\min_y \|\beta e_1 - \bar{H}_j y\| \quad \text{(Givens rotations)}
+// \end{aligned}
+//
+// One J v per inner iteration. |s_{j+1}| = ||J p + F|| is known after each rotation,
+// so the loop stops at the forcing tolerance without an extra product. J p is
+// accumulated as V_{j+1} \bar{H}_j y_j (it feeds the directional derivative F^T J p of
+// the merit function), which also gives the restart residual -F - J p for free.
+struct GmresWork {
+    matXd V;    // Krylov basis, n x (restart + 1)
+    matXd H;    // Hessenberg, (restart + 1) x restart, rotated in place
+    matXd Hbar; // unrotated copy of H
+    vecXd cs;   // Givens cosines
+    vecXd sn;   // Givens sines
+    vecXd s;    // rotated rhs beta e_1
+    vecXd y;    // least-squares coefficients
+    vecXd Hy;   // Hbar y
+    vecXd r;    // restart residual -F - J p
+    vecXd w;    // J v
+
+    void resize(i32 n, i32 restart, const ParallelOptions& par) {
+        V.resize(n, restart + 1);
+        par_first_touch(V.data(), n, restart + 1, par);
+        H.resize(restart + 1, restart);
+        Hbar.resize(restart + 1, restart);
+        cs.resize(restart);
+        sn.resize(restart);
+        s.resize(restart + 1);
+        y.resize(restart);
+        Hy.resize(restart + 1);
+        for (vecXd* v : {&r, &w}) {
+            v->resize(n);
+            par_first_touch(*v, par);
+        }
+    }
+};
+
+// Returns false if a J v product failed. On return ||J p + F|| = res_norm (in exact
+// arithmetic); iters counts J v products.
+template <typename OracleT>
+bool gmres_direction(
+    OracleT& oracle,
+    const Options& opt,
+    ecref<vecXd> x,
+    ecref<vecXd> F,
+    f64 tol,
+    eref<vecXd> p,
+    eref<vecXd> Jp,
+    GmresWork& w,
+    f64& res_norm,
+    i32& iters
+) {
+    const ParallelOptions& par = opt.parallel;
+    const i32 n = static_cast<i32>(F.size());
+    const i32 restart = static_cast<i32>(w.H.cols());
+    const i32 max_iters = (opt.nleq.gmres_max_iters > 0) ? opt.nleq.gmres_max_iters : n;
+
+    p.setZero();
+    Jp.setZero();
+    iters = 0;
+    while (true) { // restart cycles
+        par_lincomb(-1.0, F, -1.0, Jp, w.r, par);
+        const f64 beta = par_norm(w.r, par);
+        res_norm = beta;
+        if (!(beta > tol) || iters >= max_iters) break;
+
+        par_scale(1.0 / beta, w.r, w.V.col(0), par);
+        w.Hbar.setZero();
+        w.s.setZero();
+        w.s(0) = beta;
+        i32 k = 0;              // basis size of this cycle
+        bool stop = false;      // converged or breakdown
+        bool breakdown = false; // J p = -F solved exactly in the current basis
+        for (i32 j = 0; j < restart && iters < max_iters; j++) {
+            if (!oracle.try_jvp(x, w.V.col(j), w.w)) return false;
+            ++iters;
+            for (i32 i = 0; i <= j; i++) { // modified Gram-Schmidt
+                w.H(i, j) = par_dot(w.w, w.V.col(i), par);
+                par_axpy(-w.H(i, j), w.V.col(i), w.w, par);
+            }
+            const f64 h_next = par_norm(w.w, par);
+            w.H(j + 1, j) = h_next;
+            w.Hbar.col(j).head(j + 2) = w.H.col(j).head(j + 2);
+            breakdown = !(h_next > std::numeric_limits<f64>::epsilon() * beta);
+            if (!breakdown) par_scale(1.0 / h_next, w.w, w.V.col(j + 1), par);
+
+            for (i32 i = 0; i < j; i++) { // previous rotations
+                const f64 hi = w.H(i, j);
+                w.H(i, j) = w.cs(i) * hi + w.sn(i) * w.H(i + 1, j);
+                w.H(i + 1, j) = -w.sn(i) * hi + w.cs(i) * w.H(i + 1, j);
+            }
+            const f64 rad = std::hypot(w.H(j, j), w.H(j + 1, j));
+            if (!(rad > 0.0)) { // singular J on the basis: keep the first j columns
+                stop = true;
+                breakdown = false; // V.col(j) exists: J p keeps its last term
+                break;
+            }
+            k = j + 1;
+            w.cs(j) = w.H(j, j) / rad;
+            w.sn(j) = w.H(j + 1, j) / rad;
+            w.H(j, j) = rad;
+            w.H(j + 1, j) = 0.0;
+            w.s(j + 1) = -w.sn(j) * w.s(j);
+            w.s(j) = w.cs(j) * w.s(j);
+
+            res_norm = std::abs(w.s(j + 1));
+            if (breakdown || res_norm <= tol) {
+                stop = true;
+                break;
+            }
+        }
+
+        if (k == 0) break;
+        // p += V_k y, J p += V_{k+1} Hbar_k y
+        w.y.head(k) = w.H.topLeftCorner(k, k).triangularView<eig::Upper>().solve(
+            w.s.head(k)
+        );
+        if (!w.y.head(k).allFinite()) return false;
+        w.Hy.head(k + 1).noalias() = w.Hbar.topLeftCorner(k + 1, k) * w.y.head(k);
+        for (i32 i = 0; i < k; i++) {
+            par_axpy(w.y(i), w.V.col(i), p, par);
+            par_axpy(w.Hy(i), w.V.col(i), Jp, par);
+        }
+        if (!breakdown) par_axpy(w.Hy(k), w.V.col(k), Jp, par);
+        if (stop) break;
+    }
+    return p.allFinite() && Jp.allFinite();
+}
+
+} // namespace sOPT::detail
@@ -0,0 +1,331 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/mapped_buffer.hpp"
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/typedefs.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+
+namespace sOPT::detail {
+
+// Fixed-capacity L-BFGS history {(s_i, y_i, rho_i)}.
+// S and Y are n x m column-major blocks used as a ring: logical index i
+// (0 = oldest, size() - 1 = newest) lives in column slot(i). All storage is
+// allocated once in reset(); push() overwrites the oldest column when full.
+// Columns [0, size()) are always the valid ones (head is 0 until the ring fills).
+//
+// T is the storage scalar of S and Y. With T = f32 the pairs are rounded on push
+// while every dot product and update still accumulates in f64 against f64
+// vectors (gradient, direction), halving history memory and bandwidth.
+//
+// Out-of-core mode (non-empty map_dir) places S and Y in a MappedBuffer. The
+// two-loop recursion then reads ahead the next column pair (MADV_WILLNEED) and
+// drops the finished one (MADV_DONTNEED), so about two columns of S and Y stay
+// resident; the rest lives in the file / page cache.
+//
+// Compact mode (Byrd-Nocedal-Schnabel) also keeps the Gram matrices
+// SY(slot(i), slot(j)) = s_i^T y_j (i <= j) and YY = Y^T Y, updated with two
+// GEMVs per push, and applies
+// H_k = \gamma I + [S\ \gamma Y] M [S\ \gamma Y]^T,
+// M = \begin{bmatrix} R^{-T}(D + \gamma Y^T Y) R^{-1} & -R^{-T} \\ -R^{-1} & 0
+// \end{bmatrix}
+// with R = triu(S^T Y), D = diag(S^T Y), using two GEMVs over the n x m blocks.
+template <typename T = f64>
+struct LBFGSHistory {
+    eig::Map<matX<T>> S{nullptr, 0, 0}; // views into store_ or map_
+    eig::Map<matX<T>> Y{nullptr, 0, 0};
+    vecXd rho;
+    vecXd alpha; // two-loop scratch
+
+    // compact representation (slot-indexed Gram matrices + m-sized workspace)
+    matXd SY;
+    matXd YY;
+    matXd R_; // logical-order upper triangle of S^T Y
+    matXd T_; // logical-order D + gamma Y^T Y
+    vecXd a_, b_, u_, v_;
+
+    LBFGSHistory() = default;
+    LBFGSHistory(const LBFGSHistory&) = delete;
+    LBFGSHistory& operator=(const LBFGSHistory&) = delete;
+
+    // large-n kernels for the f64 two-loop (set before reset() for first-touch)
+    void set_parallel(const ParallelOptions& po) { par_ = &po; }
+
+    // Returns false if the out-of-core buffer could not be created.
+    bool reset(i32 n, i32 m, bool compact = false, const std::string& map_dir = {}) {
+        m = std::max(m, 0);
+        n_ = n;
+        T* base = nullptr;
+        const std::size_t count = static_cast<std::size_t>(n) * m;
+        if (!map_dir.empty() && count > 0) {
+            if (!map_.map(map_dir, 2 * count * sizeof(T))) return false;
+            store_.resize(0);
+            base = static_cast<T*>(map_.data());
+        } else {
+            map_.release();
+            store_.resize(static_cast<eig::Index>(2 * count));
+            base = store_.data();
+        }
+        if (par_ && !map_.mapped()) par_first_touch(base, n, 2 * m, *par_);
+        new (&S) eig::Map<matX<T>>(base, n, m);
+        new (&Y) eig::Map<matX<T>>(base + count, n, m);
+        rho.resize(m);
+        alpha.resize(m);
+        compact_ = compact;
+        if (compact_) {
+            SY.setZero(m, m);
+            YY.setZero(m, m);
+            R_.resize(m, m);
+            T_.resize(m, m);
+            a_.resize(m);
+            b_.resize(m);
+            u_.resize(m);
+            v_.resize(m);
+        }
+        clear();
+        return true;
+    }
+    void clear() {
+        head_ = 0;
+        len_ = 0;
+    }
+
+    i32 size() const { return len_; }
+    i32 capacity() const { return static_cast<i32>(S.cols()); }
+    bool empty() const { return len_ == 0; }
+
+    // column holding logical index i
+    i32 slot(i32 i) const {
+        const i32 j = head_ + i;
+        return (j >= capacity()) ? j - capacity() : j;
+    }
+    auto s(i32 i) const { return S.col(slot(i)); }
+    auto y(i32 i) const { return Y.col(slot(i)); }
+    f64 rho_at(i32 i) const { return rho[slot(i)]; }
+    f64 yy_newest() const {
+        if (len_ == 0) return qNaN<f64>;
+        const i32 j = slot(len_ - 1);
+        return compact_ ? YY(j, j) : Y.col(j).template cast<f64>().squaredNorm();
+    }
+
+    // Returns false (history unchanged) if the pair is not stored: m == 0, or the
+    // rounded pair lost positive curvature (T = f32, rho is taken from it).
+    bool push(ecref<vecXd> s_new, ecref<vecXd> y_new, f64 rho_new) {
+        const i32 m = capacity();
+        if (m == 0) return false; // no memory (steepest descent)
+        if constexpr (!is_f64_) {
+            const f64 ys_t = s_new.template cast<T>().template cast<f64>().dot(
+                y_new.template cast<T>().template cast<f64>()
+            );
+            if (!finite_pos(ys_t)) return false;
+            rho_new = 1.0 / ys_t;
+        }
+        i32 j = 0;
+        if (len_ < m) {
+            j = slot(len_);
+            ++len_;
+        } else {
+            j = head_; // drop oldest
+            head_ = (head_ + 1 == m) ? 0 : head_ + 1;
+        }
+        S.col(j) = s_new.template cast<T>();
+        Y.col(j) = y_new.template cast<T>();
+        rho[j] = rho_new;
+
+        if (compact_) { // new Gram column/row for slot j
+            const i32 L = len_;
+            if constexpr (is_f64_) {
+                SY.col(j).head(L).noalias() = S.leftCols(L).transpose() * Y.col(j);
+                YY.col(j).head(L).noalias() = Y.leftCols(L).transpose() * Y.col(j);
+            } else {
+                for (i32 i = 0; i < L; i++) {
+                    SY(i, j) = y_new.dot(S.col(i).template cast<f64>());
+                    YY(i, j) = y_new.dot(Y.col(i).template cast<f64>());
+                }
+            }
+            YY.row(j).head(L) = YY.col(j).head(L).transpose();
+        }
+        release_(j);
+        return true;
+    }
+
+    // r = H_k q with H_0 = gamma I
+    void apply_inverse(ecref<vecXd> q_in, f64 gamma, vecXd& r) {
+        if (compact_) {
+            compact_apply_(q_in, gamma, r);
+        } else {
+            two_loop_(q_in, gamma, r);
+        }
+    }
+
+  private:
+    static constexpr bool is_f64_ = std::is_same_v<T, f64>;
+
+    i32 head_ = 0; // column of the oldest pair
+    i32 len_ = 0;
+    bool compact_ = false;
+
+    // backing storage: [S | Y] contiguous, in RAM or in a mapped file
+    i32 n_ = 0;
+    vecX<T> store_;
+    MappedBuffer map_;
+    const ParallelOptions* par_ = nullptr;
+
+    // out-of-core window hints (no-ops for in-RAM storage)
+    void prefetch_(i32 j) const { advise_col_(j, true); }
+    void release_(i32 j) const { advise_col_(j, false); }
+    void advise_col_(i32 j, bool need) const {
+        if (!map_.mapped()) return;
+        const std::size_t col = static_cast<std::size_t>(n_) * sizeof(T);
+        const std::size_t y_off = col * static_cast<std::size_t>(capacity());
+        for (const std::size_t off : {col * j, y_off + col * j}) {
+            if (need) {
+                map_.will_need(off, col);
+            } else {
+                map_.dont_need(off, col);
+            }
+        }
+    }
+
+    // Mixed-precision kernels: f32 columns are widened chunk by chunk into an
+    // L1-sized f64 buffer so the f64 dot/axpy stay vectorized (a direct
+    // cast<f64>() expression does not vectorize the reduction).
+    static constexpr i32 chunk_ = 1024;
+    vecXd buf_ = vecXd(is_f64_ ? 0 : chunk_);
+
+    template <typename ColT>
+    f64 dot_(const ColT& c, ecref<vecXd> v) {
+        if constexpr (is_f64_) {
+            return par_ ? par_dot(c, v, *par_) : c.dot(v);
+        } else {
+            const i32 n = static_cast<i32>(v.size());
+            f64 acc = 0.0;
+            for (i32 i0 = 0; i0 < n; i0 += chunk_) {
+                const i32 len = std::min(chunk_, n - i0);
+                buf_.head(len) = c.segment(i0, len).template cast<f64>();
+                acc += buf_.head(len).dot(v.segment(i0, len));
+            }
+            return acc;
+        }
+    }
+    template <typename ColT>
+    void axpy_(f64 a, const ColT& c, vecXd& r) {
+        if constexpr (is_f64_) {
+            if (par_) {
+                par_axpy(a, c, r, *par_);
+            } else {
+                r.noalias() += a * c;
+            }
+        } else {
+            const i32 n = static_cast<i32>(r.size());
+            for (i32 i0 = 0; i0 < n; i0 += chunk_) {
+                const i32 len = std::min(chunk_, n - i0);
+                buf_.head(len) = c.segment(i0, len).template cast<f64>();
+                r.segment(i0, len).noalias() += a * buf_.head(len);
+            }
+        }
+    }
+
+    // two-loop recursion: 4m level-1 passes over n-vectors
+    void two_loop_(ecref<vecXd> q_in, f64 gamma, vecXd& r) {
+        if (par_) {
+            par_scale(1.0, q_in, r, *par_);
+        } else {
+            r = q_in;
+        }
+        for (i32 i = len_ - 1; i >= 0; i--) {
+            const i32 j = slot(i);
+            if (i > 0) prefetch_(slot(i - 1));
+            alpha[j] = rho[j] * dot_(S.col(j), r);
+            axpy_(-alpha[j], Y.col(j), r);
+            release_(j);
+        } // end loop 1
+
+        if (gamma != 1.0) {
+            if (par_) {
+                par_scale(gamma, r, r, *par_); // elementwise, aliasing is safe
+            } else {
+                r *= gamma;
+            }
+        }
+
+        for (i32 i = 0; i < len_; i++) {
+            const i32 j = slot(i);
+            if (i + 1 < len_) prefetch_(slot(i + 1));
+            const f64 beta = rho[j] * dot_(Y.col(j), r);
+            axpy_(alpha[j] - beta, S.col(j), r);
+            release_(j);
+        } // end loop 2
+    }
+
+    // compact form: S^T q, Y^T q (GEMV), O(m^2) small solves, then S c_s + Y c_y
+    void compact_apply_(ecref<vecXd> q_in, f64 gamma, vecXd& r) {
+        const i32 L = len_;
+        r.noalias() = gamma * q_in;
+        if (L == 0) return;
+
+        const auto Sb = S.leftCols(L);
+        const auto Yb = Y.leftCols(L);
+        auto sq = v_.head(L); // slot order
+        auto yq = u_.head(L);
+        if constexpr (is_f64_) {
+            sq.noalias() = Sb.transpose() * q_in;
+            yq.noalias() = Yb.transpose() * q_in;
+        } else { // column-wise to keep f64 accumulation without an f64 copy
+            for (i32 i = 0; i < L; i++) {
+                sq[i] = dot_(Sb.col(i), q_in);
+                yq[i] = dot_(Yb.col(i), q_in);
+            }
+        }
+
+        // gather to logical order (oldest first) so R is upper triangular
+        auto a = a_.head(L);
+        auto b = b_.head(L);
+        auto R = R_.topLeftCorner(L, L);
+        auto Tm = T_.topLeftCorner(L, L);
+        for (i32 j = 0; j < L; j++) {
+            const i32 sj = slot(j);
+            a[j] = sq[sj];
+            b[j] = yq[sj];
+            for (i32 i = 0; i <= j; i++) {
+                const i32 si = slot(i);
+                R(i, j) = SY(si, sj);
+                Tm(i, j) = gamma * YY(si, sj);
+            }
+            Tm(j, j) += SY(sj, sj); // D
+        }
+
+        // u = R^{-1} a, v = R^{-T}((D + gamma Y^T Y) u - gamma b)
+        R.template triangularView<eig::Upper>().solveInPlace(a);
+        auto v = v_.head(L);
+        v.noalias() = Tm.template selfadjointView<eig::Upper>() * a;
+        v -= gamma * b;
+        R.template triangularView<eig::Upper>().transpose().solveInPlace(v);
+
+        // scatter coefficients back to slot order: c_s = v, c_y = -gamma u
+        auto cs = b_.head(L);
+        auto cy = u_.head(L);
+        for (i32 i = 0; i < L; i++) {
+            const i32 si = slot(i);
+            cs[si] = v[i];
+            cy[si] = -gamma * a[i];
+        }
+        if constexpr (is_f64_) {
+            r.noalias() += Sb * cs;
+            r.noalias() += Yb * cy;
+        } else {
+            for (i32 i = 0; i < L; i++) {
+                axpy_(cs[i], Sb.col(i), r);
+                axpy_(cy[i], Yb.col(i), r);
+            }
+        }
+    }
+};
+
+} // namespace sOPT::detail
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "sOPT/core/vecdefs.hpp"
+
+#include <Eigen/QR>
+#include <algorithm>
+#include <cmath>
+
+namespace sOPT::detail {
+// Damped linear least-squares steps from one QR of the Jacobian
+// ref: more1978levenberg (qrsolv)
+//
+// \begin{aligned}
+// J P &= Q R \\
+// p_\lambda &= \arg\min_p \left\| \begin{bmatrix} J \\ \sqrt{\lambda} D \end{bmatrix} p
+//              + \begin{bmatrix} r \\ 0 \end{bmatrix} \right\|
+// \end{aligned}
+//
+// factor() computes the column-pivoted QR of the m x n Jacobian once. Each solve()
+// folds the n rows of sqrt(lambda) D P into a copy of R with Givens rotations
+// (O(n^3 / 3), independent of m), so a lambda sweep never touches J again.
+// lambda = 0 gives the basic Gauss-Newton solution on the numerical rank of R.
+class LeastSquaresQR {
+  public:
+    bool factor(ecref<matXd> J, ecref<vecXd> r) {
+        const i32 m = static_cast<i32>(J.rows());
+        const i32 n = static_cast<i32>(J.cols());
+        const i32 k = std::min(m, n);
+        qr_.compute(J);
+        if (qr_.info() != eig::Success) return false;
+
+        R_.setZero(n, n); // m < n: zero rows below the trapezoid
+        R_.topRows(k) = qr_.matrixQR().topRows(k).triangularView<eig::Upper>();
+        qtr_.setZero(n);
+        qtr_.head(k) = (qr_.householderQ().transpose() * r).head(k);
+        perm_ = qr_.colsPermutation().indices();
+        rank_ = static_cast<i32>(qr_.rank());
+        return R_.allFinite() && qtr_.allFinite();
+    }
+
+    // p for damping lambda >= 0 and scaling d > 0 (original column order)
+    bool solve(f64 lambda, ecref<vecXd> d, eref<vecXd> p) {
+        const i32 n = static_cast<i32>(R_.cols());
+        z_.setZero(n);
+        if (lambda > 0.0) {
+            givens_fold_(std::sqrt(lambda), d);
+            i32 nsing = n; // rank of the folded factor
+            for (i32 j = 0; j < n; j++) {
+                if (St_(j, j) == 0.0) {
+                    nsing = j;
+                    break;
+                }
+            }
+            for (i32 j = nsing - 1; j >= 0; j--) { // S z = w, S = St^T upper
+                const i32 len = nsing - j - 1;
+                const f64 sz = St_.col(j).segment(j + 1, len).dot(z_.segment(j + 1, len));
+                z_(j) = (w_(j) - sz) / St_(j, j);
+            }
+        } else if (rank_ > 0) {
+            z_.head(rank_) = R_.topLeftCorner(rank_, rank_)
+                                 .triangularView<eig::Upper>()
+                                 .solve(qtr_.head(rank_));
+        }
+        for (i32 j = 0; j < n; j++) p(perm_(j)) = -z_(j);
+        return p.allFinite();
+    }
+
+    // m(0) - m(p) = -(g^T p + 1/2 ||J p||^2) for the last solve, ||J p|| = ||R z||
+    f64 model_decrease(ecref<vecXd> g, ecref<vecXd> p) const {
+        const f64 jp2 = (R_.triangularView<eig::Upper>() * z_).squaredNorm();
+        return -(g.dot(p) + 0.5 * jp2);
+    }
+
+    i32 rank() const { return rank_; }
+
+  private:
+    // St = S^T (lower), S upper triangular with S^T S = R^T R + lambda P^T D^2 P;
+    // stored transposed so the row updates below run down contiguous columns
+    void givens_fold_(f64 sqrt_lambda, ecref<vecXd> d) {
+        const i32 n = static_cast<i32>(R_.cols());
+        St_ = R_.transpose();
+        w_ = qtr_;
+        t_.resize(n);
+        for (i32 j = 0; j < n; j++) {
+            const f64 dj = sqrt_lambda * d(perm_(j));
+            if (dj == 0.0) continue;
+            t_.tail(n - j).setZero();
+            t_(j) = dj;
+            f64 wt = 0.0; // rhs entry of the damping row
+            for (i32 k = j; k < n; k++) {
+                if (t_(k) == 0.0) continue;
+                f64 c = 0.0;
+                f64 s = 0.0;
+                if (std::abs(St_(k, k)) < std::abs(t_(k))) {
+                    const f64 cot = St_(k, k) / t_(k);
+                    s = 1.0 / std::sqrt(1.0 + cot * cot);
+                    c = s * cot;
+                } else {
+                    const f64 tan = t_(k) / St_(k, k);
+                    c = 1.0 / std::sqrt(1.0 + tan * tan);
+                    s = c * tan;
+                }
+                St_(k, k) = c * St_(k, k) + s * t_(k);
+                const f64 wk = w_(k);
+                w_(k) = c * wk + s * wt;
+                wt = -s * wk + c * wt;
+                for (i32 i = k + 1; i < n; i++) {
+                    const f64 sik = St_(i, k);
+                    St_(i, k) = c * sik + s * t_(i);
+                    t_(i) = -s * sik + c * t_(i);
+                }
+            }
+        }
+    }
+
+    eig::ColPivHouseholderQR<matXd> qr_;
+    matXd R_;   // n x n upper factor of J P
+    vecXd qtr_; // (Q^T r)_{1:n}
+    eig::VectorXi perm_;
+    i32 rank_ = 0;
+
+    matXd St_; // folded factor, transposed
+    vecXd w_;  // folded rhs
+    vecXd t_;  // damping row being eliminated
+    vecXd z_;  // permuted solution, p = -P z
+};
+
+} // namespace sOPT::detail
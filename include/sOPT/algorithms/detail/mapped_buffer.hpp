@@ -0,0 +1,107 @@
+#pragma once
+
+#include "sOPT/core/typedefs.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SOPT_HAS_MMAP 1
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define SOPT_HAS_MMAP 0
+#endif
+
+namespace sOPT::detail {
+
+// File-backed scratch buffer for out-of-core storage (POSIX only).
+// map() creates a temp file in dir, unlinks it right away, and maps it shared, so
+// dirty pages are written back to the file instead of swap and the space is
+// returned when the buffer is released. The advice helpers forward madvise hints
+// for byte ranges; callers use them to keep only a small window resident.
+class MappedBuffer {
+  public:
+    MappedBuffer() = default;
+    ~MappedBuffer() { release(); }
+    MappedBuffer(const MappedBuffer&) = delete;
+    MappedBuffer& operator=(const MappedBuffer&) = delete;
+
+    bool map(const std::string& dir, std::size_t bytes) {
+        release();
+#if SOPT_HAS_MMAP
+        if (bytes == 0) return false;
+        std::string path = (dir.empty() ? std::string(".") : dir) + "/sOPT_XXXXXX";
+        const int fd = ::mkstemp(path.data());
+        if (fd < 0) return false;
+        ::unlink(path.c_str()); // storage lives until the mapping is gone
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        addr_ = p;
+        bytes_ = bytes;
+        page_ = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        ::madvise(addr_, bytes_, MADV_SEQUENTIAL);
+        return true;
+#else
+        (void)dir;
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    void release() {
+#if SOPT_HAS_MMAP
+        if (addr_) ::munmap(addr_, bytes_);
+#endif
+        addr_ = nullptr;
+        bytes_ = 0;
+    }
+
+    bool mapped() const { return addr_ != nullptr; }
+    void* data() const { return addr_; }
+    std::size_t bytes() const { return bytes_; }
+
+    // read-ahead hint for [offset, offset + len)
+    void will_need(std::size_t offset, std::size_t len) const {
+#if SOPT_HAS_MMAP
+        advise_(offset, len, MADV_WILLNEED);
+#else
+        (void)offset;
+        (void)len;
+#endif
+    }
+    // drop [offset, offset + len) from the resident set (data stays in the file)
+    void dont_need(std::size_t offset, std::size_t len) const {
+#if SOPT_HAS_MMAP
+        advise_(offset, len, MADV_DONTNEED);
+#else
+        (void)offset;
+        (void)len;
+#endif
+    }
+
+  private:
+    void* addr_ = nullptr;
+    std::size_t bytes_ = 0;
+    std::size_t page_ = 4096;
+
+#if SOPT_HAS_MMAP
+    void advise_(std::size_t offset, std::size_t len, int advice) const {
+        if (!addr_ || len == 0 || offset >= bytes_) return;
+        // madvise needs a page-aligned start
+        const std::size_t start = offset - (offset % page_);
+        const std::size_t end = std::min(offset + len, bytes_);
+        ::madvise(static_cast<char*>(addr_) + start, end - start, advice);
+    }
+#endif
+};
+
+} // namespace sOPT::detail
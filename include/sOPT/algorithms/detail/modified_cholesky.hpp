@@ -0,0 +1,230 @@
+#pragma once
+
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/typedefs.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sOPT::detail {
+
+// Schnabel-Eskow (SE99) modified Cholesky factorization with symmetric pivoting
+// ref: schnabel1999revised, nocedal2006numerical pp.52-54
+//
+// \begin{aligned}
+// P (H + E) P^T &= L D L^T, \quad D = \mathrm{diag}(d_j) > 0, \quad
+// E = \mathrm{diag}(\delta_j) \ge 0 \\
+// c_{ij} &= h_{ij} - \textstyle\sum_{s<j} d_s l_{is} l_{js}, \quad
+// l_{ij} = c_{ij} / d_j, \quad d_j = c_{jj} + \delta_j
+// \end{aligned}
+//
+// Phase 1 is a plain LDL^T (\delta_j = 0) pivoting on the largest remaining c_ii.
+// It ends when the pivot falls below \delta = \mathtt{delta\_rel} \max(\gamma + \xi, 1)
+// or would leave a diagonal below -\mu \gamma (\mu = 0.1, \gamma = \max|h_{ii}|,
+// \xi = \max_{i \ne j}|h_{ij}|), so SPD Hessians are factored unmodified. Phase 2
+// pivots on the largest Gerschgorin lower bound g_i of the remaining block and
+// shifts each pivot just enough to dominate its column:
+//
+// \delta_j = \max\left(0,\ -c_{jj} + \max\left(\textstyle\sum_{i>j}|c_{ij}|,
+// \delta\right),\ \delta_{j-1}\right)
+//
+// The last 2 x 2 block is shifted from its eigenvalues. \max_j \delta_j stays
+// within a small multiple of the most negative eigenvalue of H, where GMW81's E
+// grows like O(n^2) on indefinite matrices.
+//
+// Right-looking and blocked (as LAPACK sytrf): inside a panel each column is
+// updated with the finished panel columns only, and the trailing matrix gets one
+// symmetric rank-nb update per panel (n^3 / 3 flops, mostly GEMM). The updated
+// diagonal c_ii and the bounds g_i of the remaining rows are kept as vectors for
+// the pivot search (g_i by the O(n) update of the paper). The workspace is reused
+// while n does not change.
+class ModifiedCholesky {
+  public:
+    // factor H (lower triangle read); false on non-finite input
+    bool compute(ecref<matXd> H, f64 delta_rel) {
+        const i32 n = static_cast<i32>(H.rows());
+        if (LD_.rows() != n) {
+            LD_.resize(n, n);
+            W_.resize(n, block_);
+            w_.resize(block_);
+            c_.resize(n);
+            g_.resize(n);
+            perm_.resize(n);
+        }
+        LD_.triangularView<eLo>() = H.triangularView<eLo>();
+        perm_.setIdentity(n);
+        shift_ = 0.0;
+        if (n == 0) return true;
+
+        f64 gamma = 0.0; // max |h_jj|
+        f64 xi = 0.0;    // max |h_ij|, i > j
+        for (i32 j = 0; j < n; j++) {
+            gamma = std::max(gamma, std::abs(LD_(j, j)));
+            if (j + 1 < n) {
+                xi = std::max(xi, LD_.col(j).tail(n - j - 1).cwiseAbs().maxCoeff());
+            }
+        }
+        if (!isfinite(gamma) || !isfinite(xi)) return false;
+
+        constexpr f64 mu = 0.1;
+        const f64 tau = std::cbrt(std::numeric_limits<f64>::epsilon());
+        const f64 delta = delta_rel * std::max(gamma + xi, 1.0);
+
+        c_ = LD_.diagonal();
+        bool phase2 = false;
+        f64 delta_prev = 0.0;
+        i32 k0 = 0; // first column of the current panel
+        while (k0 < n) {
+            const i32 k1 = std::min(k0 + block_, n);
+            i32 j = k0;
+            for (; j < k1; j++) {
+                const i32 len = n - j;
+                i32 q = 0;
+                if (phase2) {
+                    g_.tail(len).maxCoeff(&q);
+                } else {
+                    c_.tail(len).maxCoeff(&q);
+                }
+                q += j;
+                if (q != j) swap_(j, q);
+
+                const i32 jp = j - k0; // finished columns inside the panel
+                if (jp > 0) {
+                    w_.head(jp) = LD_.diagonal().segment(k0, jp).cwiseProduct(
+                        LD_.row(j).segment(k0, jp).transpose()
+                    );
+                    LD_.col(j).tail(len).noalias()
+                        -= LD_.block(j, k0, len, jp) * w_.head(jp);
+                }
+                const f64 cjj = LD_(j, j);
+                auto cj = LD_.col(j).tail(len - 1); // c_ij, i > j
+
+                if (!phase2) { // stay in phase 1 while no shift is needed
+                    const bool ok = cjj >= delta
+                        && (len == 1
+                            || (c_.tail(len - 1) - cj.cwiseAbs2() / cjj).minCoeff()
+                                   >= -mu * gamma);
+                    if (!ok) { // finish the trailing block, then pivot on g_i
+                        update_trailing_(k0, jp, j + 1);
+                        gerschgorin_(j);
+                        phase2 = true;
+                        break;
+                    }
+                    factor_column_(j, cjj);
+                    continue;
+                }
+
+                if (len == 1) { // last pivot
+                    const f64 t = std::max(tau * -cjj / (1.0 - tau), delta);
+                    shift_ = std::max({0.0, -cjj + t, delta_prev});
+                    LD_(j, j) = cjj + shift_;
+                    return finite_pos(LD_(j, j));
+                }
+                if (len == 2) { // last 2 x 2 block, shifted from its eigenvalues
+                    const f64 a = cjj;
+                    const f64 b = LD_(j + 1, j);
+                    const f64 c = c_(j + 1);
+                    const f64 mid = 0.5 * (a + c);
+                    const f64 rad = std::hypot(0.5 * (a - c), b);
+                    const f64 lo = mid - rad;
+                    const f64 hi = mid + rad;
+                    const f64 t = std::max(tau * (hi - lo) / (1.0 - tau), delta);
+                    const f64 dj = std::max({0.0, -lo + t, delta_prev});
+                    shift_ = std::max(shift_, dj);
+                    LD_(j, j) = a + dj;
+                    if (!finite_pos(LD_(j, j))) return false;
+                    LD_(j + 1, j) = b / LD_(j, j);
+                    LD_(j + 1, j + 1) = c + dj - b * LD_(j + 1, j);
+                    return finite_pos(LD_(j + 1, j + 1));
+                }
+
+                const f64 normj = cj.cwiseAbs().sum();
+                const f64 dj = std::max({0.0, -cjj + std::max(normj, delta), delta_prev});
+                delta_prev = dj;
+                shift_ = std::max(shift_, dj);
+                // g_i += |c_ij| (1 - sum_{k>j} |c_kj| / d_j)
+                g_.tail(len - 1) += (1.0 - normj / (cjj + dj)) * cj.cwiseAbs();
+                factor_column_(j, cjj + dj);
+            }
+            if (j < k1) { // entered phase 2 at column j: new panel from j
+                k0 = j;
+                continue;
+            }
+            update_trailing_(k0, k1 - k0, k1);
+            k0 = k1;
+        }
+        return true;
+    }
+
+    // b <- (P^T L D L^T P)^{-1} b
+    void solve_in_place(eref<vecXd> b) const {
+        b = perm_.transpose() * b; // b_j <- b_{perm(j)}
+        LD_.triangularView<eig::UnitLower>().solveInPlace(b);
+        b.array() /= LD_.diagonal().array();
+        LD_.triangularView<eig::UnitLower>().transpose().solveInPlace(b);
+        b = perm_ * b;
+    }
+
+    // max_j E_jj (0 => H was factored unmodified)
+    f64 max_shift() const { return shift_; }
+
+  private:
+    static constexpr i32 block_ = 64;
+    matXd LD_; // unit-lower L below the diagonal, D on the diagonal
+    matXd W_;  // L(k1:, panel) D scratch
+    vecXd w_;  // D l_j scratch (inside a panel)
+    vecXd c_;  // updated diagonal c_ii of the rows not yet factored
+    vecXd g_;  // phase 2 Gerschgorin lower bounds of the rows not yet factored
+    eig::PermutationMatrix<eig::Dynamic> perm_; // row j of LD_ is row perm(j) of H
+    f64 shift_ = 0.0;
+
+    // d_j = dj, l_ij = c_ij / d_j, c_ii -= c_ij^2 / d_j
+    void factor_column_(i32 j, f64 dj) {
+        const i32 len = static_cast<i32>(LD_.rows()) - j;
+        LD_(j, j) = dj;
+        if (len > 1) {
+            auto cj = LD_.col(j).tail(len - 1);
+            c_.tail(len - 1) -= cj.cwiseAbs2() / dj;
+            cj /= dj;
+        }
+    }
+
+    // A(r0:, r0:) -= L(r0:, k0:k0+nb) D L(r0:, k0:k0+nb)^T (lower triangle)
+    void update_trailing_(i32 k0, i32 nb, i32 r0) {
+        const i32 rows = static_cast<i32>(LD_.rows()) - r0;
+        if (rows <= 0 || nb <= 0) return;
+        const auto Lp = LD_.block(r0, k0, rows, nb);
+        W_.topLeftCorner(rows, nb).noalias()
+            = Lp * LD_.diagonal().segment(k0, nb).asDiagonal();
+        LD_.bottomRightCorner(rows, rows).triangularView<eLo>()
+            -= W_.topLeftCorner(rows, nb) * Lp.transpose();
+    }
+
+    // g_i = c_ii - sum_{k != i} |c_ik| over the (fully updated) block A(j:, j:)
+    void gerschgorin_(i32 j) {
+        const i32 n = static_cast<i32>(LD_.rows());
+        g_.tail(n - j) = LD_.diagonal().tail(n - j);
+        for (i32 k = j; k + 1 < n; k++) {
+            const auto col = LD_.col(k).tail(n - k - 1).cwiseAbs();
+            g_(k) -= col.sum();
+            g_.tail(n - k - 1) -= col;
+        }
+    }
+
+    // symmetric swap of rows/columns j < q: finished columns of L and the lower
+    // triangle of the not yet factored block A(j:, j:)
+    void swap_(i32 j, i32 q) {
+        const i32 n = static_cast<i32>(LD_.rows());
+        LD_.row(j).head(j).swap(LD_.row(q).head(j));
+        std::swap(LD_(j, j), LD_(q, q));
+        for (i32 i = j + 1; i < q; i++) std::swap(LD_(i, j), LD_(q, i));
+        if (q + 1 < n) LD_.col(j).tail(n - q - 1).swap(LD_.col(q).tail(n - q - 1));
+        std::swap(c_(j), c_(q));
+        std::swap(g_(j), g_(q));
+        std::swap(perm_.indices()(j), perm_.indices()(q));
+    }
+};
+
+} // namespace sOPT::detail
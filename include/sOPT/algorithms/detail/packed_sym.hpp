@@ -0,0 +1,82 @@
+#pragma once
+
+#include "sOPT/core/typedefs.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+namespace sOPT::detail {
+
+// Symmetric n x n matrix in packed lower-triangular storage (n (n + 1) / 2 values,
+// column j holds rows j..n-1 contiguously). Used for the dense quasi-Newton
+// inverse-Hessian approximations: every kernel is a single pass over the packed
+// columns and nothing allocates after resize().
+class PackedSym {
+  public:
+    PackedSym() = default;
+    explicit PackedSym(i32 n) { resize(n); }
+
+    void resize(i32 n) {
+        n_ = n;
+        data_.resize(static_cast<i64>(n) * (n + 1) / 2);
+    }
+    i32 rows() const { return n_; }
+
+    void set_identity() {
+        data_.setZero();
+        for (i32 j = 0; j < n_; j++) data_[offset_(j)] = 1.0;
+    }
+
+    f64 operator()(i32 i, i32 j) const {
+        return (i >= j) ? data_[offset_(j) + (i - j)] : data_[offset_(i) + (j - i)];
+    }
+
+    // out = scale * B x
+    void multiply(ecref<vecXd> x, eref<vecXd> out, f64 scale = 1.0) const {
+        out.setZero();
+        for (i32 j = 0; j < n_; j++) {
+            const i32 len = n_ - j;
+            const eig::Map<const vecXd> col(data_.data() + offset_(j), len);
+            out.tail(len).noalias() += x[j] * col; // lower part of column j
+            if (len > 1) out[j] += col.tail(len - 1).dot(x.tail(len - 1)); // B(j, j+1:)
+        }
+        if (scale != 1.0) out *= scale;
+    }
+
+    // B += a u u^T + b (u v^T + v u^T) + c v v^T
+    void rank2_update(f64 a, ecref<vecXd> u, f64 b, ecref<vecXd> v, f64 c) {
+        for (i32 j = 0; j < n_; j++) {
+            const i32 len = n_ - j;
+            eig::Map<vecXd> col(data_.data() + offset_(j), len);
+            const f64 cu = a * u[j] + b * v[j];
+            const f64 cv = b * u[j] + c * v[j];
+            col.noalias() += cu * u.tail(len) + cv * v.tail(len);
+        }
+    }
+
+    // B += a u u^T
+    void rank1_update(f64 a, ecref<vecXd> u) {
+        for (i32 j = 0; j < n_; j++) {
+            const i32 len = n_ - j;
+            eig::Map<vecXd> col(data_.data() + offset_(j), len);
+            col.noalias() += (a * u[j]) * u.tail(len);
+        }
+    }
+
+    // dense copy (diagnostics/tests)
+    matXd to_dense() const {
+        matXd M(n_, n_);
+        for (i32 j = 0; j < n_; j++) {
+            for (i32 i = j; i < n_; i++) M(i, j) = M(j, i) = (*this)(i, j);
+        }
+        return M;
+    }
+
+  private:
+    i32 n_ = 0;
+    vecXd data_;
+
+    i64 offset_(i32 j) const {
+        return static_cast<i64>(j) * n_ - static_cast<i64>(j) * (j - 1) / 2;
+    }
+};
+
+} // namespace sOPT::detail
@@ -3,6 +3,7 @@
 #include "sOPT/core/math.hpp"
 #include "sOPT/core/options.hpp"
 #include "sOPT/core/options_validation.hpp"
+#include "sOPT/core/parallel.hpp"
 #include "sOPT/core/result.hpp"
 #include "sOPT/core/status.hpp"
 #include "sOPT/core/vecdefs.hpp"
@@ -10,6 +11,7 @@
 #include "sOPT/step_size/try_full.hpp"
 
 #include <Eigen/Cholesky>
+#include <Eigen/SparseCholesky>
 #include <cmath>
 #include <optional>
 #include <type_traits>
@@ -67,12 +69,38 @@ inline EvalStatus eval_hess(OracleT& oracle, ecref<vecXd> x, eref<matXd> H) {
     }
     return H.allFinite() ? EvalStatus::ok : EvalStatus::eval_failed;
 }
+template <typename OracleT>
+inline EvalStatus
+eval_hess_sparse(OracleT& oracle, ecref<vecXd> x, const spmatXd*& H) {
+    if (!oracle.try_hessian_sparse(x, H)) { // values are checked by the oracle
+        return oracle.h_limit_reached() ? EvalStatus::max_evals : EvalStatus::eval_failed;
+    }
+    return EvalStatus::ok;
+}
+template <typename OracleT>
+inline EvalStatus eval_residual(OracleT& oracle, ecref<vecXd> x, eref<vecXd> r) {
+    // residual evals count against the function-eval budget
+    if (!oracle.try_residual(x, r)) {
+        return oracle.f_limit_reached() ? EvalStatus::max_evals : EvalStatus::eval_failed;
+    }
+    return EvalStatus::ok;
+}
+template <typename OracleT>
+inline EvalStatus eval_jacobian(OracleT& oracle, ecref<vecXd> x, eref<matXd> J) {
+    // Jacobians count as g evals; FD Jacobians also spend f evals
+    if (!oracle.try_jacobian(x, J)) {
+        const bool limit = oracle.g_limit_reached() || oracle.f_limit_reached();
+        return limit ? EvalStatus::max_evals : EvalStatus::eval_failed;
+    }
+    return EvalStatus::ok;
+}
 
 // Tolerance and termination ---------------------------------------------------
 struct TerminationScales {
     // used for relative tolerance termination
     f64 grad_ref = 1.0;
     f64 step_ref = 1.0;
+    f64 res_ref = 1.0; // max(1, ||F_0||), nonlinear equations
 };
 
 inline f64 sanitize_tol_nonneg(f64 v) {
@@ -98,6 +126,14 @@ step_tol_effective(const Options& opt, const TerminationScales* scales = nullptr
     return std::max(abs_tol, rel_tol * step_ref);
 }
 
+inline f64
+res_tol_effective(const Options& opt, const TerminationScales* scales = nullptr) {
+    const f64 abs_tol = sanitize_tol_nonneg(opt.nleq.res_tol);
+    const f64 rel_tol = sanitize_tol_nonneg(opt.nleq.res_tol_rel);
+    const f64 res_ref = scales ? sanitize_ref_pos(scales->res_ref) : 1.0;
+    return std::max(abs_tol, rel_tol * res_ref);
+}
+
 inline bool is_step_converged(
     f64 step_norm,
     const Options& opt,
@@ -130,7 +166,13 @@ inline std::optional<Status> init_common(
     TerminationScales* scales = nullptr
 ) {
     res.trace_init(opt);
-    res.x = x0;
+    if (par_enabled(opt.parallel, x0.size())) { // first-touch the iterate
+        res.x.resize(x0.size());
+        par_first_touch(res.x, opt.parallel);
+        par_scale(1.0, x0, res.x, opt.parallel);
+    } else {
+        res.x = x0;
+    }
     res.iterations = 0;
     res.status = Status::invalid_input;
 
@@ -163,7 +205,7 @@ inline std::optional<Status> init_common(
         }
     }
 
-    const f64 gnorm = g.norm();
+    const f64 gnorm = par_norm(g, opt.parallel);
     if (scales) {
         scales->grad_ref = std::max(1.0, std::abs(gnorm));
         scales->step_ref = std::max(1.0, res.x.norm());
@@ -267,7 +309,7 @@ inline std::optional<Status> post_accept_common(
         }
     }
 
-    const f64 gnorm = g.norm();
+    const f64 gnorm = par_norm(g, opt.parallel);
 
     res.trace_push(opt, oracle, f, gnorm, step_norm, alpha, diag);
 
@@ -340,6 +382,192 @@ void finalize_common(Result& res, const OracleT& oracle, f64 f, f64 grad_norm) {
     }
 }
 
+// nonlinear equations F(x) = 0 (newton_krylov, broyden) -----------------------
+// Same flow as above with the merit function f = 1/2 ||F||^2 (the Oracle's f for a
+// residual objective) and F in place of g: ||F|| is reported as grad_norm, and
+// grad_norm <= res_tol_effective stops with converged_residual. The merit gradient
+// J^T F is never formed.
+template <typename OracleT>
+inline std::optional<Status> init_equation_common(
+    OracleT& oracle,
+    const Options& opt,
+    ecref<vecXd> x0,
+    Result& res,
+    eref<vecXd> F,
+    f64& f,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop,
+    TerminationScales* scales = nullptr
+) {
+    res.trace_init(opt);
+    if (par_enabled(opt.parallel, x0.size())) { // first-touch the iterate
+        res.x.resize(x0.size());
+        par_first_touch(res.x, opt.parallel);
+        par_scale(1.0, x0, res.x, opt.parallel);
+    } else {
+        res.x = x0;
+    }
+    res.iterations = 0;
+    res.status = Status::invalid_input;
+
+    // square system
+    if (F.size() != res.x.size() || oracle.num_residuals() != res.x.size()) {
+        res.status = Status::invalid_input;
+        return res.status;
+    }
+
+    if (opt.validate_options) {
+        const OptionsValidationResult v = validate_options(opt);
+        if (!v.ok) {
+            res.status = Status::invalid_input;
+            return res.status;
+        }
+    }
+
+    { // first merit eval, then F from the Oracle's residual slot
+        const EvalStatus stf = eval_func(oracle, res.x, f);
+        if (stf != EvalStatus::ok) {
+            res.status = to_status(stf);
+            return res.status;
+        }
+        const EvalStatus str = eval_residual(oracle, res.x, F);
+        if (str != EvalStatus::ok) {
+            res.status = to_status(str);
+            return res.status;
+        }
+    }
+
+    const f64 Fnorm = par_norm(F, opt.parallel);
+    if (scales) {
+        scales->res_ref = std::max(1.0, std::abs(Fnorm));
+        scales->step_ref = std::max(1.0, res.x.norm());
+    }
+    IterDiagnostics diag;
+    res.trace_push(opt, oracle, f, Fnorm, 0.0, 0.0, diag);
+
+    if (!isfinite(f) || !isfinite(Fnorm)) {
+        res.status = Status::nan_detected;
+        return res.status;
+    }
+
+    IterInfo it;
+    it.iter = 0;
+    it.f = f;
+    it.grad_norm = Fnorm;
+    it.step_norm = 0.0;
+    it.alpha = 0.0;
+    it.diag = diag;
+
+    if (on_iter) on_iter(it);
+    if (should_stop && should_stop(it)) {
+        res.status = Status::user_terminated;
+        return res.status;
+    }
+
+    return std::nullopt;
+}
+
+inline std::optional<Status> pre_step_checks_equation(
+    f64 f,
+    f64 Fnorm,
+    const Options& opt,
+    const TerminationScales* scales = nullptr
+) {
+    if (!isfinite(f) || !isfinite(Fnorm)) {
+        return Status::nan_detected;
+    }
+    if (Fnorm <= res_tol_effective(opt, scales)) {
+        return Status::converged_residual;
+    }
+    return std::nullopt;
+}
+
+// accept step, refresh F (usually the residual slot of the last line-search
+// probe), trace + callbacks, then the step / f-change checks
+template <typename OracleT>
+inline std::optional<Status> post_accept_equation_common(
+    OracleT& oracle,
+    const Options& opt,
+    Result& res,
+    vecXd& x,
+    f64& f,
+    eref<vecXd> F,
+    vecXd& x_next,
+    f64 f_next,
+    f64 f_prev,
+    f64 alpha,
+    f64 step_norm,
+    const IterDiagnostics& diag,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop,
+    const TerminationScales* scales = nullptr
+) {
+    x.swap(x_next);
+    f = f_next;
+    ++res.iterations;
+
+    {
+        const EvalStatus str = eval_residual(oracle, x, F);
+        if (str != EvalStatus::ok) {
+            res.status = to_status(str);
+            return res.status;
+        }
+    }
+
+    const f64 Fnorm = par_norm(F, opt.parallel);
+
+    res.trace_push(opt, oracle, f, Fnorm, step_norm, alpha, diag);
+
+    IterInfo it;
+    it.iter = res.iterations;
+    it.f = f;
+    it.grad_norm = Fnorm;
+    it.step_norm = step_norm;
+    it.alpha = alpha;
+    it.diag = diag;
+
+    if (on_iter) on_iter(it);
+    if (should_stop && should_stop(it)) {
+        res.status = Status::user_terminated;
+        return res.status;
+    }
+
+    return check_step_convergence(step_norm, f_prev, f, opt, scales);
+}
+
+// next inexact-Newton forcing term (opt.newton_cg.forcing) from the current and
+// previous residual norms of the outer equation (||g|| in newton_cg, ||F|| in
+// newton_krylov). lin_res_norm = ||previous linear model residual at the
+// accepted step|| (choice 1). Floored at 0.5 tol / norm against oversolving.
+inline f64 forcing_term(
+    const NewtonCGOptions& ncg,
+    f64 eta_prev,
+    f64 norm,
+    f64 norm_prev,
+    f64 lin_res_norm,
+    f64 tol
+) {
+    f64 eta = ncg.eta0;
+    switch (ncg.forcing) {
+    case ForcingTerm::constant: eta = ncg.eta0; break;
+    case ForcingTerm::ew_choice1: {
+        const f64 phi = 0.5 * (1.0 + std::sqrt(5.0));
+        eta = std::abs(norm - lin_res_norm) / norm_prev;
+        const f64 safe = std::pow(eta_prev, phi);
+        if (safe > 0.1) eta = std::max(eta, safe);
+        break;
+    }
+    case ForcingTerm::ew_choice2: {
+        eta = ncg.ew_gamma * std::pow(norm / norm_prev, ncg.ew_alpha);
+        const f64 safe = ncg.ew_gamma * std::pow(eta_prev, ncg.ew_alpha);
+        if (safe > 0.1) eta = std::max(eta, safe);
+        break;
+    }
+    }
+    if (tol > 0.0) eta = std::max(eta, 0.5 * tol / norm);
+    return std::min(eta, ncg.eta_max);
+}
+
 // run step size strategy algo or try full step
 // step wrapper returns StepStatus, not bool
 //
@@ -365,7 +593,8 @@ inline StepStatus run_step(
     ecref<vecXd> p,
     f64& alpha,
     vecXd& x_next,
-    f64& f_next
+    f64& f_next,
+    bool try_full = true // false: skip the unit-step probe even if opt.ls.try_full_step
 ) {
     auto map_raw = [&](const auto& raw_result) -> StepStatus {
         // Query budgets after the step attempt has run, so limits crossed
@@ -389,13 +618,16 @@ inline StepStatus run_step(
         }
     };
 
-    if (opt.ls.try_full_step) {
+    oracle.ls_begin();
+    if (opt.ls.try_full_step && try_full && uses_try_full_v<StepStrategy>) {
         const auto raw_result
             = TryFull<StepStrategy>{step}(oracle, x, f, g, p, alpha, x_next, f_next, opt);
+        oracle.ls_end();
         return map_raw(raw_result);
     }
 
     const auto raw_result = step(oracle, x, f, g, p, alpha, x_next, f_next, opt);
+    oracle.ls_end();
     return map_raw(raw_result);
 }
 
@@ -460,6 +692,53 @@ inline f64 condition_estimate_power_iteration(ecref<matXd> H, i32 iters, f64 eps
     return (isfinite(cond) && cond >= 1.0) ? cond : qNaN<f64>;
 }
 
+// sparse lower-triangle H: same estimate, products through the symmetric view and
+// the inverse iteration on a sparse LDL^T (no dense copy)
+inline f64 condition_estimate_power_iteration(const spmatXd& H, i32 iters, f64 eps) {
+    const i32 n = static_cast<i32>(H.rows());
+    if (n <= 0 || H.cols() != n) {
+        return qNaN<f64>;
+    }
+    const auto Hsym = H.selfadjointView<eig::Lower>();
+
+    const i32 kmax = std::max(1, iters);
+    const f64 eps_safe = std::max(eps, 1e-16);
+
+    vecXd v = vecXd::Ones(n) / std::sqrt(static_cast<f64>(n));
+    vecXd w(n);
+    f64 lambda_max = qNaN<f64>;
+    for (i32 k = 0; k < kmax; k++) {
+        w.noalias() = Hsym * v;
+        const f64 wn = w.norm();
+        if (!(wn > eps_safe) || !isfinite(wn)) return qNaN<f64>;
+        v = w / wn;
+        w.noalias() = Hsym * v;
+        lambda_max = std::abs(v.dot(w));
+    }
+    if (!(lambda_max > eps_safe) || !isfinite(lambda_max)) return qNaN<f64>;
+
+    eig::SimplicialLDLT<spmatXd, eig::Lower> ldlt(H);
+    if (ldlt.info() != eig::Success) return qNaN<f64>;
+    const auto D = ldlt.vectorD();
+    const f64 min_abs_diag = D.cwiseAbs().minCoeff();
+    if (!(min_abs_diag > eps_safe) || !isfinite(min_abs_diag)) return qNaN<f64>;
+
+    // inverse power iteration for the smallest eigenvalue magnitude
+    vecXd u = vecXd::Ones(n) / std::sqrt(static_cast<f64>(n));
+    f64 lambda_min = qNaN<f64>;
+    for (i32 k = 0; k < kmax; ++k) {
+        w = ldlt.solve(u);
+        const f64 zn = w.norm();
+        if (!(zn > eps_safe) || !isfinite(zn)) return qNaN<f64>;
+        u = w / zn;
+        w.noalias() = Hsym * u;
+        lambda_min = std::abs(u.dot(w));
+    }
+    if (!(lambda_min > eps_safe) || !isfinite(lambda_min)) return qNaN<f64>;
+    const f64 cond = lambda_max / lambda_min;
+    return (isfinite(cond) && cond >= 1.0) ? cond : qNaN<f64>;
+}
+
 inline void maybe_fill_hessian_diagnostics(
     const Options& opt,
     ecref<matXd> H,
@@ -497,4 +776,41 @@ inline void maybe_fill_hessian_diagnostics(
         return;
     }
 }
+
+// sparse Hessian (lower triangle): diagonal bounds, the diagonal proxy, or the sparse
+// power / inverse iteration estimate
+inline void maybe_fill_hessian_diagnostics(
+    const Options& opt,
+    const spmatXd& H,
+    IterDiagnostics& diag
+) {
+    if (!opt.diag.enabled) return;
+    if (H.rows() <= 0 || H.cols() != H.rows()) return;
+
+    const vecXd d = H.diagonal();
+    if (opt.diag.record_hessian_diag_bounds) {
+        diag.hdiag_min = d.minCoeff();
+        diag.hdiag_max = d.maxCoeff();
+    }
+
+    const f64 eps = std::max(opt.diag.cond_eps, 1e-16);
+    switch (opt.diag.cond_mode) {
+    case ConditionEstimateMode::off: return;
+    case ConditionEstimateMode::diagonal_proxy: {
+        const f64 dmax = d.cwiseAbs().maxCoeff();
+        const f64 dmin = d.cwiseAbs().minCoeff();
+        if (isfinite(dmax) && isfinite(dmin)) {
+            diag.cond_est = dmax / std::max(dmin, eps);
+        }
+        return;
+    }
+    case ConditionEstimateMode::power_iteration:
+        diag.cond_est = condition_estimate_power_iteration(
+            H,
+            opt.diag.cond_power_iters,
+            opt.diag.cond_eps
+        );
+        return;
+    }
+}
 } // namespace sOPT::detail
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <cmath>
+
+namespace sOPT::detail {
+
+// Extra secant pairs from the gradients a line search already evaluated
+// (opt.qn.harvest_pairs > 0, recorded by the oracle during the step).
+//
+// Trial points x_k + a_t p_k lie on the search ray, so a pair anchored at x_k is
+// parallel to the accepted s_k and is erased by the s_k update. Trial pairs are
+// anchored at the previous iterate instead:
+//
+// \begin{aligned}
+// s_t &= x_k + a_t p_k - x_{k-1} = s_{k-1} + a_t p_k \\
+// y_t &= g(x_k + a_t p_k) - g_{k-1}
+// \end{aligned}
+//
+// A trial is used only if y_t^T s_t > curv_tol\, s_t^T s_t and s_t is not nearly
+// parallel to s_k or s_{k-1} (|cos| <= 1 - opt.qn.harvest_indep_tol). push(s_t,
+// y_t, y_t^T s_t) is called oldest trial first; the caller then pushes (s_k, y_k).
+// The accepted point's own probe (a_t == alpha) is skipped. Returns the number of
+// pairs passed to push.
+template <typename OracleT, typename PushFn>
+i32 harvest_trial_pairs(
+    const OracleT& oracle,
+    const Options& opt,
+    f64 alpha,
+    ecref<vecXd> p,
+    ecref<vecXd> s,
+    ecref<vecXd> s_prev,
+    ecref<vecXd> g_prev,
+    f64 curv_tol,
+    vecXd& st,
+    vecXd& yt,
+    PushFn&& push
+) {
+    const ParallelOptions& par = opt.parallel;
+    const f64 cos_max = 1.0 - opt.qn.harvest_indep_tol;
+    const f64 s_norm = par_norm(s, par);
+    const f64 s_prev_norm = par_norm(s_prev, par);
+    if (!finite_pos(s_norm) || !finite_pos(s_prev_norm)) return 0;
+
+    i32 pushed = 0;
+    for (i32 i = 0; i < oracle.ls_trial_count(); i++) {
+        const f64 a = oracle.ls_trial_alpha(i);
+        if (!finite_pos(a) || a == alpha) continue;
+
+        par_lincomb(1.0, s_prev, a, p, st, par);
+        par_lincomb(1.0, oracle.ls_trial_grad(i), -1.0, g_prev, yt, par);
+
+        const f64 ss = par_squared_norm(st, par);
+        const f64 ys = par_dot(yt, st, par);
+        if (!isfinite(ys) || !(ys > curv_tol * ss)) continue; // curvature
+
+        const f64 st_norm = std::sqrt(ss);
+        const f64 cos_s = par_dot(st, s, par) / (st_norm * s_norm);
+        const f64 cos_prev = par_dot(st, s_prev, par) / (st_norm * s_prev_norm);
+        if (!(std::abs(cos_s) <= cos_max) || !(std::abs(cos_prev) <= cos_max)) {
+            continue; // (nearly) linearly dependent on an existing pair
+        }
+
+        push(st, yt, ys);
+        ++pushed;
+    }
+    return pushed;
+}
+
+} // namespace sOPT::detail
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/algorithms/detail/packed_sym.hpp"
 #include "sOPT/algorithms/detail/solver_common.hpp"
 #include "sOPT/core/callback.hpp"
 #include "sOPT/core/constants.hpp"
@@ -52,9 +53,9 @@ Result dfp(
     f64 alpha = 0.0;
     f64 last_ys = qNaN<f64>;
     f64 last_ys_cos = qNaN<f64>;
-    matXd B(n, n);
+    detail::PackedSym B(n); // packed lower triangle
     detail::TerminationScales term_scales;
-    B.setIdentity();
+    B.set_identity();
 
     if (auto st = detail::init_common(
             oracle,
@@ -80,9 +81,9 @@ Result dfp(
             break;
         }
 
-        p.noalias() = -(B * g);
+        B.multiply(g, p, -1.0);
         if (g.dot(p) >= 0.0) { // ensure descent direction
-            B.setIdentity();
+            B.set_identity();
             p.noalias() = -g;
         }
 
@@ -157,16 +158,14 @@ Result dfp(
             }
         }
 
-        By.noalias() = B.selfadjointView<Eigen::Lower>() * y;
+        B.multiply(y, By);
         const f64 yBy = y.dot(By);
         const f64 s_floor = tol_max * s.squaredNorm();
         const f64 y_floor = tol_max * y.squaredNorm();
         // Curvature condition: y^T s = s^T y > 0 and y^T B y > 0 (with tolerance)
         if (isfinite(ys) && isfinite(yBy) && ys > s_floor && yBy > y_floor) {
-            // inverse-DFP update
-            B.noalias() += (s * s.transpose()) / ys;
-            B.noalias() -= (By * By.transpose()) / yBy;
-            B = B.selfadjointView<Eigen::Lower>();
+            // inverse-DFP update: B += s s^T / ys - By (By)^T / yBy
+            B.rank2_update(1.0 / ys, s, 0.0, By, -1.0 / yBy);
         } else {
             // skip unstable update when curvature is invalid/small
         }
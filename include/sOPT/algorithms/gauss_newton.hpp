@@ -0,0 +1,167 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/least_squares_qr.hpp"
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/step_size/armijo.hpp"
+
+namespace sOPT {
+// Gauss-Newton (line-search) for f(x) = 1/2 ||r(x)||^2
+// ref: nocedal2006numerical pp.254-256
+//
+// \begin{aligned}
+// p_k &= \arg\min_p \|J_k p + r_k\| \quad \text{(QR of } J_k) \\
+// x_{k+1} &= x_k + \alpha_k p_k
+// \end{aligned}
+//
+// Needs is_least_squares_v<Obj> (residual + num_residuals; jacobian optional, FD
+// otherwise). f = 1/2 ||r||^2 and g = J^T r come from the Oracle, which shares the
+// residual/Jacobian evaluations with this loop. p_k is a descent direction whenever
+// g_k != 0, also for rank-deficient J_k (basic solution on the numerical rank).
+namespace detail {
+template <typename Obj, typename StepStrategy>
+Result gauss_newton_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+
+    Result res;
+    const i32 n = static_cast<i32>(x0.size());
+    const i32 m = oracle.num_residuals();
+
+    vecXd g(n);    // gradient J^T r
+    vecXd r(m);    // residual
+    matXd J(m, n); // residual Jacobian
+    detail::LeastSquaresQR qr;
+    vecXd p(n);    // Gauss-Newton direction
+    vecXd x_next(n);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    detail::TerminationScales term_scales;
+
+    if (auto st = detail::init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = g.norm();
+
+        if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        // r_k and J_k are the Oracle's slots from the f/g evals at x_k
+        if (auto st = detail::eval_residual(oracle, res.x, r); st != EvalStatus::ok) {
+            res.status = detail::to_status(st);
+            break;
+        }
+        if (auto st = detail::eval_jacobian(oracle, res.x, J); st != EvalStatus::ok) {
+            res.status = detail::to_status(st);
+            break;
+        }
+        if (!qr.factor(J, r) || !qr.solve(0.0, vecXd::Ones(n), p)) {
+            res.status = Status::linear_solve_failed;
+            break;
+        }
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = g.dot(p);
+        }
+
+        const detail::StepStatus step_status = detail::run_step(
+            oracle,
+            opt,
+            step_strategy,
+            res.x,
+            f,
+            g,
+            p,
+            alpha,
+            x_next,
+            f_next
+        );
+        if (step_status != detail::StepStatus::accepted) {
+            res.status = detail::to_status(step_status);
+            break;
+        }
+
+        const f64 f_prev = f;
+        const f64 step_norm = (x_next - res.x).norm();
+        if (auto st = detail::post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    } // end iteration
+    detail::finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj, typename StepStrategy>
+Result gauss_newton(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    static_assert(
+        is_least_squares_v<Obj>,
+        "gauss_newton: Obj needs residual(x, r) and num_residuals()"
+    );
+    return detail::gauss_newton_impl(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
+
+// overload default Armijo
+template <typename Obj>
+Result gauss_newton(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return gauss_newton(obj, x0, opt, Armijo{}, on_iter, should_stop);
+}
+
+} // namespace sOPT
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sOPT {
+// Matrix-free Gauss-Newton-CG with Levenberg-Marquardt damping for
+// f(x) = 1/2 ||r(x)||^2
+// ref: nocedal2006numerical pp.258-262, madsen2004methods pp.24-27
+//
+// \begin{aligned}
+// \|(J_k^T J_k + \lambda_k I) p_k + g_k\| &\le \eta_k \|g_k\| \quad \text{(CG)} \\
+// \rho_k &= \frac{f(x_k) - f(x_k + p_k)}{-(g_k^T p_k + \tfrac12 \|J_k p_k\|^2)}
+// \end{aligned}
+//
+// J_k is only touched through oracle.try_jvp / try_vjp (one of each per CG
+// iteration), so memory is O(m + n). J_k p_k is accumulated inside CG, so the
+// predicted reduction costs no extra product. \eta_k = min(0.5, sqrt(||g_k||)).
+// Damping update as in levenberg_marquardt (Nielsen), with D = I and
+// \lambda_0 = lm_tau ||J_0 g_0||^2 / ||g_0||^2 (Rayleigh quotient of J^T J along g).
+// A rejected step re-runs CG at the same x_k with the larger \lambda.
+//
+// Needs is_least_squares_v<Obj>. g = J^T r uses vjp when there is no jacobian();
+// with neither, the Oracle builds an FD Jacobian for g (O(mn) memory).
+namespace detail {
+
+struct GaussNewtonCGWork {
+    vecXd r;   // CG residual -g - (J^T J + lambda I) p
+    vecXd d;   // CG search direction
+    vecXd Ad;  // (J^T J + lambda I) d
+    vecXd Jd;  // J d (length m)
+    vecXd Jp;  // J p (length m)
+
+    void resize(i32 n, i32 m, const ParallelOptions& par) {
+        for (vecXd* v : {&r, &d, &Ad}) {
+            v->resize(n);
+            par_first_touch(*v, par);
+        }
+        for (vecXd* v : {&Jd, &Jp}) {
+            v->resize(m);
+            par_first_touch(*v, par);
+        }
+    }
+};
+
+// CG on (J^T J + lambda I) p = -g from p = 0. Returns false if a Jacobian product
+// failed.
+template <typename OracleT>
+bool gauss_newton_cg_direction(
+    OracleT& oracle,
+    const Options& opt,
+    ecref<vecXd> x,
+    ecref<vecXd> g,
+    f64 gnorm,
+    f64 lambda,
+    eref<vecXd> p,
+    GaussNewtonCGWork& w,
+    i32& cg_iters
+) {
+    const ParallelOptions& par = opt.parallel;
+    const i32 n = static_cast<i32>(g.size());
+    const i32 max_iters = (opt.lsq.cg_max_iters > 0) ? opt.lsq.cg_max_iters : n;
+    const f64 tol = std::min(0.5, std::sqrt(gnorm)) * gnorm;
+
+    p.setZero();
+    w.Jp.setZero();
+    par_scale(-1.0, g, w.r, par);
+    par_scale(1.0, w.r, w.d, par);
+    f64 rr = par_squared_norm(w.r, par);
+
+    cg_iters = 0;
+    for (i32 j = 0; j < max_iters; j++) {
+        if (!oracle.try_jvp(x, w.d, w.Jd)) return false;
+        if (!oracle.try_vjp(x, w.Jd, w.Ad)) return false;
+        par_axpy(lambda, w.d, w.Ad, par);
+        ++cg_iters;
+
+        const f64 dAd = par_dot(w.d, w.Ad, par); // >= lambda ||d||^2 > 0
+        if (!(dAd > 0.0)) break;
+
+        const f64 a = rr / dAd;
+        par_axpy(a, w.d, p, par);
+        par_axpy(a, w.Jd, w.Jp, par);
+        par_axpy(-a, w.Ad, w.r, par);
+        const f64 rr_next = par_squared_norm(w.r, par);
+        if (std::sqrt(rr_next) <= tol) break;
+
+        par_lincomb(1.0, w.r, rr_next / rr, w.d, w.d, par);
+        rr = rr_next;
+    }
+    return p.allFinite();
+}
+
+template <typename Obj>
+Result gauss_newton_cg_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const i32 m = oracle.num_residuals();
+    const ParallelOptions& par = opt.parallel;
+    const LeastSquaresOptions& lsq = opt.lsq;
+    vecXd g(n); // gradient J^T r
+    vecXd p(n); // damped Gauss-Newton step
+    vecXd x_next(n);
+    for (vecXd* v : {&g, &p, &x_next}) detail::par_first_touch(*v, par);
+    detail::GaussNewtonCGWork work;
+    work.resize(n, m, par);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 lambda = -1.0; // set from J_0 g_0
+    f64 nu = 2.0;
+    detail::TerminationScales term_scales;
+
+    if (auto st = detail::init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = detail::par_norm(g, par);
+
+        if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        if (lambda < 0.0) {
+            if (!oracle.try_jvp(res.x, g, work.Jd)) {
+                res.status = Status::eval_failed;
+                break;
+            }
+            const f64 rq = detail::par_squared_norm(work.Jd, par) / (gnorm * gnorm);
+            lambda = lsq.lm_tau * (rq > 0.0 ? rq : 1.0);
+        }
+
+        // trial steps at x_k until one is accepted
+        bool accepted = false;
+        f64 step_norm = 0.0;
+        while (!accepted) {
+            i32 cg_iters = 0;
+            const bool ok = detail::gauss_newton_cg_direction(
+                oracle,
+                opt,
+                res.x,
+                g,
+                gnorm,
+                lambda,
+                p,
+                work,
+                cg_iters
+            );
+            res.cg_iters += cg_iters;
+            if (!ok) {
+                res.status
+                    = oracle.f_limit_reached() ? Status::max_evals : Status::eval_failed;
+                break;
+            }
+            step_norm = detail::par_norm(p, par);
+            const f64 pred = -(detail::par_dot(g, p, par)
+                               + 0.5 * detail::par_squared_norm(work.Jp, par));
+
+            detail::par_lincomb(1.0, res.x, 1.0, p, x_next, par);
+            const EvalStatus f_status = eval_func(oracle, x_next, f_next);
+            if (f_status == EvalStatus::max_evals) {
+                res.status = Status::max_evals;
+                break;
+            }
+
+            f64 rho = -std::numeric_limits<f64>::infinity();
+            if (f_status == EvalStatus::ok && pred > 0.0) {
+                // both reductions at roundoff level of f: trust the model
+                const f64 f_round
+                    = 10.0 * std::numeric_limits<f64>::epsilon() * std::max(1.0, f);
+                const f64 ared = f - f_next;
+                rho = (std::abs(ared) <= f_round && pred <= f_round) ? 1.0 : ared / pred;
+            }
+
+            if (rho > lsq.lm_eta_accept) {
+                accepted = true;
+                const f64 t = 2.0 * rho - 1.0;
+                lambda *= std::max(1.0 / 3.0, 1.0 - t * t * t);
+                nu = 2.0;
+            } else {
+                ++res.tr_rejected;
+                lambda *= nu;
+                nu *= 2.0;
+                // larger lambda only shortens the step
+                const f64 x_scale = std::max(1.0, detail::par_norm(res.x, par));
+                const f64 step_min = std::max(
+                    step_tol_effective(opt, &term_scales),
+                    std::numeric_limits<f64>::epsilon() * x_scale
+                );
+                if (!(step_norm > step_min) || !isfinite(lambda)) {
+                    res.status = Status::converged_step;
+                    break;
+                }
+            }
+        } // end trial steps
+        if (!accepted) break;
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = detail::par_dot(g, p, par);
+        }
+
+        const f64 f_prev = f;
+        if (auto st = detail::post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                1.0,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    } // end iteration
+    detail::finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj>
+Result gauss_newton_cg(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    static_assert(
+        is_least_squares_v<Obj>,
+        "gauss_newton_cg: Obj needs residual(x, r) and num_residuals()"
+    );
+    return detail::gauss_newton_cg_impl(obj, x0, opt, on_iter, should_stop);
+}
+
+} // namespace sOPT
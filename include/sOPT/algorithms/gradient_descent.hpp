@@ -8,8 +8,204 @@
 #include "sOPT/core/vecdefs.hpp"
 #include "sOPT/problem/oracle.hpp"
 #include "sOPT/step_size/armijo.hpp"
+#include "sOPT/step_size/spectral.hpp"
+
+#include <algorithm>
+#include <vector>
 
 namespace sOPT {
+namespace detail {
+// gradient_descent with a line-search-free step rule (BarzilaiBorwein,
+// AdaptiveLipschitz): alpha_k from s_{k-1} = x_k - x_{k-1}, y_{k-1} = g_k - g_{k-1}.
+// f is evaluated only by the nonmonotone safeguard (opt.gd.nonmonotone_window > 0):
+// x_k - alpha g_k must satisfy
+// f_{k+1} \leq \max_{0 \leq j < M} f_{k-j} - c_1 \alpha \|g_k\|^2
+// (ref: grippo1986nonmonotone, raydan1997barzilai), backtracking by opt.ls.rho.
+// Without it, f is NaN in the trace and callbacks and is evaluated once at exit.
+template <typename Obj, typename StepRule>
+Result gradient_descent_step_rule(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const GradientDescentOptions& gd = opt.gd;
+    const bool safeguard = gd.nonmonotone_window > 0;
+    vecXd x_next(n); // x_k - alpha g_k, then s_k
+    vecXd g(n);      // gradient
+    vecXd y(n);      // g_k, then y_k
+    vecXd p;         // -g (safeguard only)
+    for (vecXd* v : {&x_next, &g, &y}) par_first_touch(*v, par);
+    if (safeguard) {
+        p.resize(n);
+        par_first_touch(p, par);
+    }
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    TerminationScales term_scales;
+
+    Options opt_ls; // opt with ls.alpha0 = alpha_k, for the safeguard's Armijo
+    std::vector<f64> f_hist; // last nonmonotone_window accepted f (ring)
+    if (safeguard) {
+        opt_ls = opt;
+        f_hist.reserve(static_cast<std::size_t>(gd.nonmonotone_window));
+    }
+
+    if (auto st = init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+    if (safeguard) f_hist.push_back(f);
+
+    f64 sTs = 0.0;
+    f64 sTy = 0.0;
+    f64 yTy = 0.0;
+    f64 theta = inf<f64>; // AdaptiveLipschitz: alpha_{k-1} / alpha_{k-2}
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = par_norm(g, par);
+
+        const f64 f_check = safeguard ? f : 0.0; // f is only tracked with the safeguard
+        if (auto st = pre_step_checks(f_check, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        }
+
+        const f64 alpha_prev = alpha;
+        if (k == 0) {
+            alpha = step_rule_alpha_init(gnorm, term_scales.step_ref, gd);
+        } else if constexpr (std::is_same_v<StepRule, BarzilaiBorwein>) {
+            alpha = bb_alpha(sTs, sTy, yTy, k, alpha_prev, gd);
+        } else {
+            alpha = adaptive_lipschitz_alpha(sTs, yTy, alpha_prev, theta, gd);
+        }
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = -gnorm * gnorm;
+        }
+
+        if (safeguard) {
+            par_scale(-1.0, g, p, par);
+            opt_ls.ls.alpha0 = alpha;
+            const f64 f_ref = *std::max_element(f_hist.begin(), f_hist.end());
+            const StepStatus step_status = run_step(
+                oracle,
+                opt_ls,
+                Armijo{},
+                res.x,
+                f_ref,
+                g,
+                p,
+                alpha,
+                x_next,
+                f_next,
+                false
+            );
+            if (step_status != StepStatus::accepted) {
+                res.status = to_status(step_status);
+                break;
+            }
+        } else {
+            par_lincomb(1.0, res.x, -alpha, g, x_next, par);
+            f_next = qNaN<f64>;
+        }
+        if (k > 0) theta = alpha / alpha_prev;
+
+        par_scale(1.0, g, y, par); // g_k
+        const f64 f_prev = f;
+        const f64 step_norm = alpha * gnorm;
+        if (safeguard) {
+            if (auto st = post_accept_with_step_status(
+                    oracle,
+                    opt,
+                    res,
+                    res.x,
+                    f,
+                    g,
+                    x_next,
+                    f_next,
+                    f_prev,
+                    alpha,
+                    step_norm,
+                    diag,
+                    on_iter,
+                    should_stop,
+                    &term_scales
+                )) {
+                res.status = *st;
+                break;
+            }
+            // ring of the last nonmonotone_window f values, f_j at j % window
+            if (static_cast<i32>(f_hist.size()) < gd.nonmonotone_window) {
+                f_hist.push_back(f);
+            } else {
+                f_hist[static_cast<std::size_t>((k + 1) % gd.nonmonotone_window)] = f;
+            }
+        } else {
+            if (auto st = post_accept_common(
+                    oracle,
+                    opt,
+                    res,
+                    res.x,
+                    f,
+                    g,
+                    x_next,
+                    f_next,
+                    alpha,
+                    step_norm,
+                    diag,
+                    on_iter,
+                    should_stop
+                )) {
+                res.status = *st;
+                break;
+            }
+            if (!isfinite(step_norm)) {
+                res.status = Status::nan_detected;
+                break;
+            }
+            if (is_step_converged(step_norm, opt, &term_scales)) {
+                res.status = Status::converged_step;
+                break;
+            }
+        }
+
+        // s_k = x_{k+1} - x_k (x_next holds x_k after the swap), y_k = g_{k+1} - g_k
+        par_lincomb(1.0, res.x, -1.0, x_next, x_next, par);
+        par_lincomb(1.0, g, -1.0, y, y, par);
+        sTs = step_norm * step_norm;
+        sTy = par_dot(x_next, y, par);
+        yTy = par_squared_norm(y, par);
+    }
+
+    if (!safeguard && res.iterations > 0) { // f at the returned iterate
+        f64 fx = qNaN<f64>;
+        if (eval_func(oracle, res.x, fx) == EvalStatus::ok) f = fx;
+    }
+    finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
 // Gradient Descent
 //
 // \begin{aligned}
@@ -18,7 +214,8 @@ namespace sOPT {
 // x_{k+1} &= x_k + \alpha_k p_k
 // \end{aligned}
 //
-// where $\alpha_k > 0$ is chosen by a step-size rule
+// where $\alpha_k > 0$ is chosen by a step-size rule: a line search, or one of the
+// line-search-free rules BarzilaiBorwein / AdaptiveLipschitz (spectral.hpp)
 template <typename Obj, typename StepStrategy>
 Result gradient_descent(
     const Obj& obj,
@@ -32,12 +229,15 @@ Result gradient_descent(
     Result res;
 
     const i32 n = static_cast<i32>(x0.size());
-    vecXd x_next = x0;
+    const ParallelOptions& par = opt.parallel;
+    vecXd x_next(n);
     f64 f = 0.0;
     f64 f_next = 0.0;
     f64 alpha = 0.0;
     vecXd g(n); // gradient
     vecXd p(n); // descent direction
+    for (vecXd* v : {&x_next, &g, &p}) detail::par_first_touch(*v, par);
+    detail::par_scale(1.0, x0, x_next, par);
     detail::TerminationScales term_scales;
 
     // check if early stop
@@ -59,7 +259,7 @@ Result gradient_descent(
 
     // iteration loop
     for (i32 k = 0; k < opt.term.max_iters; k++) {
-        const f64 gnorm = g.norm();
+        const f64 gnorm = detail::par_norm(g, par);
 
         // check for invalid solutions
         if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
@@ -68,10 +268,10 @@ Result gradient_descent(
         }
 
         // init diagnostics
-        p.noalias() = -g; // descent direction
+        detail::par_scale(-1.0, g, p, par); // descent direction
         IterDiagnostics diag;
         if (opt.diag.enabled && opt.diag.record_directional_derivative) {
-            diag.gTp = g.dot(p);
+            diag.gTp = detail::par_dot(g, p, par);
         }
 
         const detail::StepStatus step_status = detail::run_step(
@@ -93,7 +293,7 @@ Result gradient_descent(
         }
 
         const f64 f_prev = f;
-        const f64 step_norm = (x_next - res.x).norm();
+        const f64 step_norm = detail::par_distance(x_next, res.x, par);
         if (auto st = detail::post_accept_with_step_status(
                 oracle,
                 opt,
@@ -122,6 +322,44 @@ Result gradient_descent(
     return res;
 }
 
+// overloads for the line-search-free step rules (stateless tags, state lives in the
+// solver)
+template <typename Obj>
+Result gradient_descent(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    BarzilaiBorwein,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return detail::gradient_descent_step_rule<Obj, BarzilaiBorwein>(
+        obj,
+        x0,
+        opt,
+        on_iter,
+        should_stop
+    );
+}
+
+template <typename Obj>
+Result gradient_descent(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    AdaptiveLipschitz,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return detail::gradient_descent_step_rule<Obj, AdaptiveLipschitz>(
+        obj,
+        x0,
+        opt,
+        on_iter,
+        should_stop
+    );
+}
+
 // overload (default to Armijo)
 template <typename Obj>
 Result gradient_descent(
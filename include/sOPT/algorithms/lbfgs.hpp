@@ -1,6 +1,8 @@
 #pragma once
 
+#include "sOPT/algorithms/detail/lbfgs_history.hpp"
 #include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/algorithms/detail/trial_pairs.hpp"
 #include "sOPT/core/callback.hpp"
 #include "sOPT/core/options.hpp"
 #include "sOPT/core/result.hpp"
@@ -9,7 +11,6 @@
 #include "sOPT/step_size/wolfe.hpp"
 
 #include <algorithm>
-#include <deque>
 #include <limits>
 
 namespace sOPT {
@@ -38,14 +39,16 @@ namespace sOPT {
 // \end{aligned}
 //
 // Strong Wolfe line search is commonly used to help ensure $y_k^T s_k > 0$.
-template <typename Obj, typename StepStrategy>
-Result lbfgs(
+namespace detail {
+// HistT: history storage scalar (f64, or f32 with opt.lbfgs.f32_history)
+template <typename HistT, typename Obj, typename StepStrategy>
+Result lbfgs_impl(
     const Obj& obj,
     ecref<vecXd> x0,
     const Options& opt,
     const StepStrategy& step_strategy,
-    const IterCallback& on_iter = {},
-    const StopCallback& should_stop = {}
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
 ) {
     Oracle<Obj> oracle(obj, opt);
     Result res;
@@ -53,10 +56,12 @@ Result lbfgs(
     const i32 n = static_cast<i32>(x0.size());
     const i32 m = opt.lbfgs.memory;
     vecXd g(n), g_prev(n);
-    vecXd p(n), q(n), r(n); // temp gradient-like vectors for first and second loops
+    vecXd p(n), r(n);       // r = H_k g from the two-loop recursion
     vecXd s(n), y(n);       // see bfgs.hpp
 
     vecXd x_next(n);
+    const ParallelOptions& par = opt.parallel;
+    for (vecXd* v : {&g, &g_prev, &p, &r, &s, &y, &x_next}) detail::par_first_touch(*v, par);
     f64 f = 0.0;
     f64 f_next = 0.0;
     f64 alpha = 0.0;
@@ -64,11 +69,21 @@ Result lbfgs(
     f64 last_ys_cos = qNaN<f64>;
     detail::TerminationScales term_scales;
 
-    // history (most recent at back)
-    std::deque<vecXd> S;
-    std::deque<vecXd> Y;
-    std::deque<f64> RHO;
-    svec<f64> alpha_i(((m > 0) ? m : 0), 0.0);
+    // line-search trial pairs (opt.qn.harvest_pairs > 0)
+    const bool harvest = opt.qn.harvest_pairs > 0 && m > 0;
+    bool have_prev = false;  // s_old/g_old hold the previous step
+    vecXd s_old, g_old;      // s_{k-1}, g_{k-1}
+    vecXd s_trial, y_trial;  // trial pair scratch
+    if (harvest) {
+        for (vecXd* v : {&s_old, &g_old, &s_trial, &y_trial}) {
+            v->resize(n);
+            detail::par_first_touch(*v, par);
+        }
+    }
+
+    // history (preallocated n x m ring, most recent last)
+    LBFGSHistory<HistT> hist;
+    hist.set_parallel(par);
 
     if (auto st = detail::init_common(
             oracle,
@@ -85,56 +100,40 @@ Result lbfgs(
         detail::finalize_common(res, oracle, f, g.norm());
         return res;
     }
+    if (!hist.reset(n, m, opt.lbfgs.compact, opt.lbfgs.history_dir)) {
+        res.status = Status::allocation_failed; // out-of-core history unavailable
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
 
     for (i32 k = 0; k < opt.term.max_iters; k++) {
-        const f64 gnorm = g.norm();
+        const f64 gnorm = detail::par_norm(g, par);
 
         if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
             res.status = *st;
             break;
         }
 
-        // Two-loop recursion
-        q = g;
-        const i32 L = static_cast<i32>(S.size());
-
-        if (L > 0) {
-            for (i32 i = L - 1; i >= 0; i--) {
-                alpha_i[i] = RHO[i] * S[i].dot(q);
-                q.noalias() -= alpha_i[i] * Y[i];
-            } // end loop 1
-        }
-
         // Initial H_0 scaling
+        const i32 L = hist.size();
+        f64 gamma = 1.0;
         if (L > 0 && opt.lbfgs.h0_auto_scale) {
-            const vecXd& s_last = S.back();
-            const vecXd& y_last = Y.back();
-            const f64 sy = s_last.dot(y_last);
-            const f64 yy = y_last.dot(y_last);
+            const f64 sy = 1.0 / hist.rho_at(L - 1);
+            const f64 yy = hist.yy_newest();
 
-            f64 gamma = 1.0; // fallback if gamma calculations fail
             if (yy > 0.0) gamma = sy / yy;
-            if (!isfinite(gamma)) gamma = 1.0;
+            if (!isfinite(gamma)) gamma = 1.0; // fallback if gamma calculations fail
             gamma = std::clamp(gamma, opt.lbfgs.h0_scale_min, opt.lbfgs.h0_scale_max);
-
-            r.noalias() = gamma * q;
-        } else {
-            r = q;
         }
 
-        // loop 2
-        for (i32 i = 0; i < L; i++) {
-            const f64 beta = RHO[i] * Y[i].dot(r);
-            r.noalias() += S[i] * (alpha_i[i] - beta);
-        }
-
-        p.noalias() = -r;
+        // Two-loop recursion (or compact form with opt.lbfgs.compact)
+        hist.apply_inverse(g, gamma, r);
+        detail::par_scale(-1.0, r, p, par);
 
-        if (g.dot(p) >= 0.0) { // ensure descent direction or reset vectors
-            p.noalias() = -g;
-            S.clear();
-            Y.clear();
-            RHO.clear();
+        const f64 gTp = detail::par_dot(g, p, par);
+        if (gTp >= 0.0) { // ensure descent direction or reset vectors
+            detail::par_scale(-1.0, g, p, par);
+            hist.clear();
         }
 
         IterDiagnostics diag;
@@ -163,14 +162,18 @@ Result lbfgs(
             break;
         }
 
-        const f64 step_norm = (x_next - res.x).norm();
+        const f64 step_norm = detail::par_distance(x_next, res.x, par);
         const bool step_converged
             = detail::is_step_converged(step_norm, opt, &term_scales);
         const f64 f_prev = f;
         if (!step_converged) {
+            if (harvest) { // keep the previous pair as the trial-pair anchor
+                s.swap(s_old);
+                g_prev.swap(g_old);
+            }
             // save secant pair data before x/g are updated
-            s.noalias() = x_next - res.x;
-            g_prev = g;
+            detail::par_lincomb(1.0, x_next, -1.0, res.x, s, par);
+            detail::par_scale(1.0, g, g_prev, par);
         }
 
         if (auto st = detail::post_accept_with_step_status(
@@ -194,11 +197,11 @@ Result lbfgs(
             break;
         }
 
-        y.noalias() = g - g_prev;
+        detail::par_lincomb(1.0, g, -1.0, g_prev, y, par);
 
         // curvature condition (skip or restart if bad)
-        const f64 ys = y.dot(s);
-        const f64 ss = s.squaredNorm();
+        const f64 ys = detail::par_dot(y, s, par);
+        const f64 ss = detail::par_squared_norm(s, par);
         if (opt.diag.enabled && opt.diag.record_qn_curvature) {
             const f64 denom = y.norm() * s.norm();
             const f64 ys_cos
@@ -213,34 +216,52 @@ Result lbfgs(
 
         if (!std::isfinite(ys) || ys <= 0.0) {
             // restart on invalid/negative curvature
-            S.clear();
-            Y.clear();
-            RHO.clear();
+            hist.clear();
         } else if (ys > tol_strict * ss) { // curvature acceptance threshold
-            // push pair
-            if (m > 0) {
-                if ((i32)S.size() == m) {
-                    S.pop_front();
-                    Y.pop_front();
-                    RHO.pop_front();
-                }
-                S.push_back(s);
-                Y.push_back(y);
-                RHO.push_back(1.0 / ys);
-            } else {
-                // m == 0 => no memory (degenerates to steepest descent)
-                S.clear();
-                Y.clear();
-                RHO.clear();
+            if (harvest && have_prev) { // older than (s, y): pushed first
+                res.harvested_pairs += detail::harvest_trial_pairs(
+                    oracle,
+                    opt,
+                    alpha,
+                    p,
+                    s,
+                    s_old,
+                    g_old,
+                    tol_strict,
+                    s_trial,
+                    y_trial,
+                    [&](ecref<vecXd> s_t, ecref<vecXd> y_t, f64 ys_t) {
+                        hist.push(s_t, y_t, 1.0 / ys_t);
+                    }
+                );
             }
+            // push pair (m == 0 => no memory, degenerates to steepest descent)
+            hist.push(s, y, 1.0 / ys);
         } else {
             // curvature too small (likely noisy): skip update
         }
+        have_prev = true;
     } // end iterations
 
     detail::finalize_common(res, oracle, f, g.norm());
     return res;
 }
+} // namespace detail
+
+template <typename Obj, typename StepStrategy>
+Result lbfgs(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    if (opt.lbfgs.f32_history) {
+        return detail::lbfgs_impl<f32>(obj, x0, opt, step_strategy, on_iter, should_stop);
+    }
+    return detail::lbfgs_impl<f64>(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
 
 // overload default Strong Wolfe
 template <typename Obj>
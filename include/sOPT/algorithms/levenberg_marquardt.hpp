@@ -0,0 +1,211 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/least_squares_qr.hpp"
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sOPT {
+// Levenberg-Marquardt for f(x) = 1/2 ||r(x)||^2
+// ref: more1978levenberg, madsen2004methods pp.24-27
+//
+// \begin{aligned}
+// (J_k^T J_k + \lambda_k D_k^2)\, p_k &= -J_k^T r_k \\
+// \rho_k &= \frac{f(x_k) - f(x_k + p_k)}{-(g_k^T p_k + \tfrac12 \|J_k p_k\|^2)}
+// \end{aligned}
+//
+// p_k is the least-squares solution of [J_k; sqrt(lambda_k) D_k] p = -[r_k; 0]. J_k is
+// factored once per iterate (detail::LeastSquaresQR); a rejected step only refolds
+// the damping rows into R by Givens rotations, so the lambda sweep costs O(n^3) and
+// one residual per trial. Damping update (Nielsen):
+// \lambda <- \lambda \max(1/3, 1 - (2\rho - 1)^3), \nu = 2 if \rho > eta_accept,
+// otherwise \lambda <- \nu \lambda, \nu <- 2 \nu. D_k = diag of the running max column
+// norms of J (opt.lsq.lm_scale), \lambda_0 = lm_tau \max_j (J_0^T J_0)_{jj} / D_{jj}^2.
+//
+// Needs is_least_squares_v<Obj>; J comes from jacobian() or the FD fallback
+// (opt.fd.fallback_jac). Rejected trials are counted in res.tr_rejected.
+namespace detail {
+template <typename Obj>
+Result levenberg_marquardt_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+
+    Result res;
+    const i32 n = static_cast<i32>(x0.size());
+    const i32 m = oracle.num_residuals();
+    const LeastSquaresOptions& lsq = opt.lsq;
+
+    vecXd g(n);    // gradient J^T r
+    vecXd r(m);    // residual
+    matXd J(m, n); // residual Jacobian
+    detail::LeastSquaresQR qr;
+    vecXd d = vecXd::Zero(n); // scaling D
+    vecXd p(n);               // LM step
+    vecXd x_next(n);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 lambda = -1.0; // set from J_0
+    f64 nu = 2.0;
+    detail::TerminationScales term_scales;
+
+    if (auto st = detail::init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = g.norm();
+
+        if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        // r_k and J_k are the Oracle's slots from the f/g evals at x_k
+        if (auto st = detail::eval_residual(oracle, res.x, r); st != EvalStatus::ok) {
+            res.status = detail::to_status(st);
+            break;
+        }
+        if (auto st = detail::eval_jacobian(oracle, res.x, J); st != EvalStatus::ok) {
+            res.status = detail::to_status(st);
+            break;
+        }
+        if (!qr.factor(J, r)) {
+            res.status = Status::linear_solve_failed;
+            break;
+        }
+
+        const vecXd cnorm = J.colwise().norm().transpose();
+        if (lsq.lm_scale) {
+            for (i32 j = 0; j < n; j++) {
+                d(j) = std::max(d(j), cnorm(j));
+                if (d(j) == 0.0) d(j) = 1.0; // column not seen yet
+            }
+        } else {
+            d.setOnes();
+        }
+        if (lambda < 0.0) {
+            const f64 scaled = (cnorm.array() / d.array()).square().maxCoeff();
+            lambda = lsq.lm_tau * (scaled > 0.0 ? scaled : 1.0);
+        }
+
+        // trial steps at x_k until one is accepted
+        bool accepted = false;
+        f64 step_norm = 0.0;
+        while (!accepted) {
+            if (!qr.solve(lambda, d, p)) {
+                res.status = Status::linear_solve_failed;
+                break;
+            }
+            step_norm = p.norm();
+            const f64 pred = qr.model_decrease(g, p);
+
+            x_next.noalias() = res.x + p;
+            const EvalStatus f_status = eval_func(oracle, x_next, f_next);
+            if (f_status == EvalStatus::max_evals) {
+                res.status = Status::max_evals;
+                break;
+            }
+
+            f64 rho = -std::numeric_limits<f64>::infinity();
+            if (f_status == EvalStatus::ok && pred > 0.0) {
+                // both reductions at roundoff level of f: trust the model
+                const f64 f_round
+                    = 10.0 * std::numeric_limits<f64>::epsilon() * std::max(1.0, f);
+                const f64 ared = f - f_next;
+                rho = (std::abs(ared) <= f_round && pred <= f_round) ? 1.0 : ared / pred;
+            }
+
+            if (rho > lsq.lm_eta_accept) {
+                accepted = true;
+                const f64 t = 2.0 * rho - 1.0;
+                lambda *= std::max(1.0 / 3.0, 1.0 - t * t * t);
+                nu = 2.0;
+            } else {
+                ++res.tr_rejected;
+                lambda *= nu;
+                nu *= 2.0;
+                // larger lambda only shortens the step
+                const f64 x_scale = std::max(1.0, res.x.norm());
+                const f64 step_min = std::max(
+                    step_tol_effective(opt, &term_scales),
+                    std::numeric_limits<f64>::epsilon() * x_scale
+                );
+                if (!(step_norm > step_min) || !isfinite(lambda)) {
+                    res.status = Status::converged_step;
+                    break;
+                }
+            }
+        } // end trial steps
+        if (!accepted) break;
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = g.dot(p);
+        }
+
+        const f64 f_prev = f;
+        if (auto st = detail::post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                1.0,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    } // end iteration
+    detail::finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj>
+Result levenberg_marquardt(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    static_assert(
+        is_least_squares_v<Obj>,
+        "levenberg_marquardt: Obj needs residual(x, r) and num_residuals()"
+    );
+    return detail::levenberg_marquardt_impl(obj, x0, opt, on_iter, should_stop);
+}
+
+} // namespace sOPT
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/algorithms/detail/modified_cholesky.hpp"
 #include "sOPT/algorithms/detail/solver_common.hpp"
 #include "sOPT/core/callback.hpp"
 #include "sOPT/core/options.hpp"
@@ -9,6 +10,9 @@
 
 #include <Eigen/Cholesky>
 #include <Eigen/LU>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+#include <vector>
 
 namespace sOPT {
 // Damped Newton (Globalized Newton)
@@ -23,15 +27,21 @@ namespace sOPT {
 // with $\lambda_k \ge 0$ and $\alpha_k \in (0,1]$.
 // $\lambda_k$ is increased until $H_k + \lambda_k I$ is SPD, and $\alpha_k$ is chosen by
 // a line search
-
+//
+// With opt.newton.sparse, objectives with has_hessian_sparse_v use the sparse path:
+// H_k + \lambda_k I is factored with a sparse LDL^T whose symbolic analysis
+// (fill-reducing ordering and elimination tree) is computed once for the fixed
+// pattern and reused. opt.newton.modified_cholesky is dense-only (validation error
+// with opt.newton.sparse).
+namespace detail {
 template <typename Obj, typename StepStrategy>
-Result newton(
+Result newton_dense_impl(
     const Obj& obj,
     ecref<vecXd> x0,
     const Options& opt,
     const StepStrategy& step_strategy,
-    const IterCallback& on_iter = {},
-    const StopCallback& should_stop = {}
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
 ) {
     Oracle<Obj> oracle(obj, opt);
 
@@ -40,7 +50,9 @@ Result newton(
 
     vecXd g(n);       // gradient
     matXd H(n, n);    // hessian
-    matXd Hmod(n, n); // modified hessian: Hmod = H + lambda * I
+    matXd Hmod;       // modified hessian: Hmod = H + lambda * I (damping tries only)
+    if (!opt.newton.modified_cholesky) Hmod.resize(n, n);
+    detail::ModifiedCholesky mchol; // opt.newton.modified_cholesky workspace
     vecXd p(n);       // descent direction
     vecXd x_next(n);
     f64 f = 0.0;
@@ -84,29 +96,37 @@ Result newton(
 
         p.noalias() = -g;
         bool solved = false;
-        f64 lambda = 0.0;
 
-        for (i32 t = 0; t <= opt.newton.damping_max_tries; t++) {
-            if (t == 0) {
-                Hmod.noalias() = H;
-            } else {
-                if (t == 1)
-                    lambda = opt.newton.damping0;
-                else
-                    lambda *= opt.newton.damping_scale;
-                Hmod.noalias() = H;
-                Hmod.diagonal().array() += lambda; // Hmod = H + I \lambda
+        if (opt.newton.modified_cholesky) { // one factorization: H + E = L D L^T
+            if (mchol.compute(H, opt.newton.mc_min_pivot)) {
+                mchol.solve_in_place(p);
+                solved = p.allFinite();
+                if (!solved) p.noalias() = -g;
             }
+        } else {
+            f64 lambda = 0.0;
+            for (i32 t = 0; t <= opt.newton.damping_max_tries; t++) {
+                if (t == 0) {
+                    Hmod.noalias() = H;
+                } else {
+                    if (t == 1)
+                        lambda = opt.newton.damping0;
+                    else
+                        lambda *= opt.newton.damping_scale;
+                    Hmod.noalias() = H;
+                    Hmod.diagonal().array() += lambda; // Hmod = H + I \lambda
+                }
 
-            eig::LLT<matXd> llt(Hmod); // factor Hmod = L * L^T
-            if (llt.info() == eig::Success) {
-                p = llt.solve(p);
-                if (p.allFinite()) {
-                    solved = true;
-                    break;
+                eig::LLT<matXd> llt(Hmod); // factor Hmod = L * L^T
+                if (llt.info() == eig::Success) {
+                    p = llt.solve(p);
+                    if (p.allFinite()) {
+                        solved = true;
+                        break;
+                    }
                 }
-            }
-        } // end newton damping
+            } // end newton damping
+        }
 
         if (!solved) {                // fallback solve for p
             eig::LDLT<matXd> ldlt(H); // factor Hmod = L * D * L^T
@@ -177,6 +197,186 @@ Result newton(
     return res;
 }
 
+template <typename Obj, typename StepStrategy>
+Result newton_sparse_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+
+    Result res;
+    const i32 n = static_cast<i32>(x0.size());
+
+    vecXd g(n);                 // gradient
+    const spmatXd* H = nullptr; // hessian (lower triangle, oracle's cached slot)
+    vecXd p(n);                 // descent direction
+    vecXd x_next(n);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    detail::TerminationScales term_scales;
+
+    // symbolic analysis is redone only if the pattern changes
+    eig::SimplicialLDLT<spmatXd, eig::Lower> ldlt;
+    std::vector<spmatXd::StorageIndex> analyzed_outer;
+    std::vector<spmatXd::StorageIndex> analyzed_inner;
+
+    if (auto st = detail::init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = g.norm();
+
+        if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        IterDiagnostics diag;
+        {
+            const detail::EvalStatus hess_status
+                = detail::eval_hess_sparse(oracle, res.x, H);
+            if (hess_status != detail::EvalStatus::ok) {
+                res.status = detail::to_status(hess_status);
+                break;
+            }
+            detail::maybe_fill_hessian_diagnostics(opt, *H, diag);
+        } // end diagnostics
+
+        { // H is compressed by the oracle: n + 1 outer and nnz inner indices
+            const spmatXd::StorageIndex* outer = H->outerIndexPtr();
+            const spmatXd::StorageIndex* inner = H->innerIndexPtr();
+            const std::size_t nnz = static_cast<std::size_t>(H->nonZeros());
+            if (analyzed_inner.size() != nnz
+                || !std::equal(analyzed_outer.begin(), analyzed_outer.end(), outer)
+                || !std::equal(analyzed_inner.begin(), analyzed_inner.end(), inner)) {
+                ldlt.analyzePattern(*H);
+                analyzed_outer.assign(outer, outer + n + 1);
+                analyzed_inner.assign(inner, inner + nnz);
+            }
+        }
+
+        bool solved = false;
+        f64 lambda = 0.0;
+        for (i32 t = 0; t <= opt.newton.damping_max_tries; t++) {
+            if (t == 1)
+                lambda = opt.newton.damping0;
+            else if (t > 1)
+                lambda *= opt.newton.damping_scale;
+            ldlt.setShift(lambda); // factor H + I \lambda
+            ldlt.factorize(*H);
+            if (ldlt.info() == eig::Success && ldlt.vectorD().minCoeff() > 0.0) {
+                p.noalias() = ldlt.solve(-g);
+                if (p.allFinite()) {
+                    solved = true;
+                    break;
+                }
+            }
+        } // end newton damping
+
+        if (!solved) { // fallback: indefinite LDL^T solve on H
+            ldlt.setShift(0.0);
+            ldlt.factorize(*H);
+            if (ldlt.info() == eig::Success) {
+                p.noalias() = ldlt.solve(-g);
+                solved = p.allFinite();
+            }
+        }
+        if (!solved) {
+            res.status = Status::linear_solve_failed;
+            break;
+        }
+
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = g.dot(p);
+        }
+
+        const detail::StepStatus step_status = detail::run_step(
+            oracle,
+            opt,
+            step_strategy,
+            res.x,
+            f,
+            g,
+            p,
+            alpha,
+            x_next,
+            f_next
+        );
+        if (step_status != detail::StepStatus::accepted) {
+            res.status = detail::to_status(step_status);
+            break;
+        }
+
+        const f64 f_prev = f;
+        const f64 step_norm = (x_next - res.x).norm();
+        if (auto st = detail::post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    } // end iteration
+    detail::finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj, typename StepStrategy>
+Result newton(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    if constexpr (has_hessian_sparse_v<Obj>) {
+        if (opt.newton.sparse) {
+            return detail::newton_sparse_impl(
+                obj,
+                x0,
+                opt,
+                step_strategy,
+                on_iter,
+                should_stop
+            );
+        }
+    }
+    return detail::newton_dense_impl(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
+
 // overload default Armijo
 template <typename Obj>
 Result newton(
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/step_size/armijo.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sOPT {
+// Newton-CG (truncated Newton, line-search)
+// ref: nocedal2006numerical pp.168-170, eisenstat1996choosing
+//
+// \begin{aligned}
+// \|H_k p_k + g_k\| &\le \eta_k \|g_k\| \quad \text{(CG on } H_k p = -g_k) \\
+// x_{k+1} &= x_k + \alpha_k p_k
+// \end{aligned}
+//
+// H_k is only touched through Hessian-vector products (oracle.try_hv), so memory
+// is O(n). CG stops at the forcing tolerance, after max_cg_iters, or at the first
+// direction d with d^T H_k d <= 0 (the last CG iterate is returned; at the first
+// inner iteration that is -M^{-1} g_k). Forcing terms (opt.newton_cg.forcing):
+//
+// \begin{aligned}
+// \text{choice 1:}\ \eta_k &= \frac{\big|\|g_k\| - \|g_{k-1} + \alpha_{k-1} H_{k-1}
+//     p_{k-1}\|\big|}{\|g_{k-1}\|} \\
+// \text{choice 2:}\ \eta_k &= \gamma \left(\|g_k\| / \|g_{k-1}\|\right)^{\alpha}
+// \end{aligned}
+//
+// with the Eisenstat-Walker safeguards, capped at eta_max and floored at
+// 0.5 grad_tol / ||g_k|| to avoid oversolving near termination.
+namespace detail {
+
+struct NewtonCGWork {
+    vecXd r;  // residual H p + g
+    vecXd z;  // preconditioned residual
+    vecXd d;  // CG search direction
+    vecXd Hd; // H d
+    vecXd Hp; // H p (for choice 1)
+
+    void resize(i32 n, const ParallelOptions& par) {
+        for (vecXd* v : {&r, &z, &d, &Hd, &Hp}) {
+            v->resize(n);
+            par_first_touch(*v, par);
+        }
+    }
+};
+
+// (preconditioned) CG on H p = -g from p = 0. Returns false if an Hv product or
+// the preconditioner failed.
+template <typename OracleT>
+bool newton_cg_direction(
+    OracleT& oracle,
+    const Options& opt,
+    ecref<vecXd> x,
+    ecref<vecXd> g,
+    f64 gnorm,
+    f64 eta,
+    eref<vecXd> p,
+    NewtonCGWork& w,
+    i32& cg_iters,
+    bool& neg_curvature
+) {
+    const ParallelOptions& par = opt.parallel;
+    const bool precond = opt.newton_cg.precondition;
+    const i32 n = static_cast<i32>(g.size());
+    const i32 max_iters
+        = (opt.newton_cg.max_cg_iters > 0) ? opt.newton_cg.max_cg_iters : n;
+    const f64 tol = eta * gnorm;
+
+    p.setZero();
+    w.Hp.setZero();
+    par_scale(1.0, g, w.r, par);
+    if (precond) {
+        if (!oracle.try_precondition(x, w.r, w.z)) return false;
+    } else {
+        par_scale(1.0, w.r, w.z, par);
+    }
+    par_scale(-1.0, w.z, w.d, par);
+    f64 rz = par_dot(w.r, w.z, par);
+
+    cg_iters = 0;
+    neg_curvature = false;
+    for (i32 j = 0; j < max_iters; j++) {
+        if (!oracle.try_hv(x, w.d, w.Hd)) return false;
+        ++cg_iters;
+
+        const f64 dHd = par_dot(w.d, w.Hd, par);
+        if (!(dHd > 0.0)) { // negative (or zero) curvature along d
+            neg_curvature = true;
+            if (j == 0) { // -M^{-1} g, with H d as H p
+                par_scale(1.0, w.d, p, par);
+                par_scale(1.0, w.Hd, w.Hp, par);
+            }
+            break;
+        }
+
+        const f64 a = rz / dHd;
+        par_axpy(a, w.d, p, par);
+        par_axpy(a, w.Hd, w.Hp, par);
+        par_axpy(a, w.Hd, w.r, par);
+        if (par_norm(w.r, par) <= tol) break;
+
+        if (precond) {
+            if (!oracle.try_precondition(x, w.r, w.z)) return false;
+        } else {
+            par_scale(1.0, w.r, w.z, par);
+        }
+        const f64 rz_next = par_dot(w.r, w.z, par);
+        par_lincomb(-1.0, w.z, rz_next / rz, w.d, w.d, par);
+        rz = rz_next;
+    }
+    return p.allFinite();
+}
+
+template <typename Obj, typename StepStrategy>
+Result newton_cg_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const NewtonCGOptions& ncg = opt.newton_cg;
+    vecXd g(n); // gradient
+    vecXd p(n); // truncated Newton direction
+    vecXd x_next(n);
+    vecXd lin_res(n); // g_{k-1} + alpha_{k-1} H_{k-1} p_{k-1} (choice 1)
+    for (vecXd* v : {&g, &p, &x_next, &lin_res}) detail::par_first_touch(*v, par);
+    detail::NewtonCGWork work;
+    work.resize(n, par);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    detail::TerminationScales term_scales;
+
+    f64 eta = ncg.eta0;
+    f64 gnorm_prev = 0.0;
+    f64 lin_res_norm = 0.0;
+
+    if (auto st = detail::init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = detail::par_norm(g, par);
+
+        if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        if (k > 0) { // forcing term
+            eta = detail::forcing_term(
+                ncg,
+                eta,
+                gnorm,
+                gnorm_prev,
+                lin_res_norm,
+                opt.term.grad_tol
+            );
+        } // end forcing term
+
+        i32 cg_iters = 0;
+        bool neg_curvature = false;
+        if (!detail::newton_cg_direction(
+                oracle,
+                opt,
+                res.x,
+                g,
+                gnorm,
+                eta,
+                p,
+                work,
+                cg_iters,
+                neg_curvature
+            )) { // Hv product or preconditioner failed
+            res.status
+                = oracle.any_limit_reached() ? Status::max_evals : Status::eval_failed;
+            break;
+        }
+        res.cg_iters += cg_iters;
+        if (neg_curvature) ++res.neg_curvature;
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = detail::par_dot(g, p, par);
+        }
+
+        const detail::StepStatus step_status = detail::run_step(
+            oracle,
+            opt,
+            step_strategy,
+            res.x,
+            f,
+            g,
+            p,
+            alpha,
+            x_next,
+            f_next
+        );
+        if (step_status != detail::StepStatus::accepted) {
+            res.status = detail::to_status(step_status);
+            break;
+        }
+
+        if (ncg.forcing == ForcingTerm::ew_choice1) {
+            detail::par_lincomb(1.0, g, alpha, work.Hp, lin_res, par);
+            lin_res_norm = detail::par_norm(lin_res, par);
+        }
+        gnorm_prev = gnorm;
+
+        const f64 f_prev = f;
+        const f64 step_norm = detail::par_distance(x_next, res.x, par);
+        if (auto st = detail::post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    } // end iteration
+    detail::finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj, typename StepStrategy>
+Result newton_cg(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return detail::newton_cg_impl(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
+
+// overload default Armijo
+template <typename Obj>
+Result newton_cg(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return newton_cg(obj, x0, opt, Armijo{}, on_iter, should_stop);
+}
+
+} // namespace sOPT
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/gmres.hpp"
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/step_size/armijo.hpp"
+
+#include <algorithm>
+
+namespace sOPT {
+// Jacobian-free Newton-Krylov (inexact Newton, line-search) for F(x) = 0
+// ref: kelley2003solving pp.57-70, knoll2004jacobian, eisenstat1996choosing
+//
+// \begin{aligned}
+// \|J_k p_k + F_k\| &\le \eta_k \|F_k\| \quad \text{(GMRES on } J_k p = -F_k) \\
+// x_{k+1} &= x_k + \alpha_k p_k, \quad
+// \phi(x_{k+1}) \le \phi(x_k) + c_1 \alpha_k F_k^T J_k p_k, \quad
+// \phi = \tfrac12 \|F\|^2
+// \end{aligned}
+//
+// F is the residual of an is_least_squares_v objective with num_residuals() == n.
+// J_k is only touched through oracle.try_jvp (analytic jvp, jacobian(), or FD
+// around the residual slot: one residual per product with opt.fd.fallback_jac =
+// fd_forward). GMRES(opt.nleq.gmres_restart) returns J_k p_k with p_k, so the
+// merit slope F_k^T J_k p_k <= -(1 - \eta_k) \|F_k\|^2 costs nothing; the step
+// strategy gets a vector with that inner product against p_k in place of
+// \nabla\phi_k = J_k^T F_k, which is never formed. Forcing terms come from
+// opt.newton_cg (forcing, eta0, eta_max, ew_gamma, ew_alpha) with ||F|| in place of
+// ||g||, floored at 0.5 res_tol / ||F_k||.
+namespace detail {
+template <typename Obj, typename StepStrategy>
+Result newton_krylov_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const NewtonCGOptions& ncg = opt.newton_cg;
+    vecXd F(n);  // residual
+    vecXd p(n);  // inexact Newton direction
+    vecXd Jp(n); // J p from GMRES
+    vecXd gp(n); // merit slope carrier, gp^T p = F^T J p
+    vecXd x_next(n);
+    vecXd lin_res(n); // F_{k-1} + alpha_{k-1} J_{k-1} p_{k-1} (choice 1)
+    for (vecXd* v : {&F, &p, &Jp, &gp, &x_next, &lin_res}) {
+        detail::par_first_touch(*v, par);
+    }
+    detail::GmresWork work;
+    work.resize(n, std::min(opt.nleq.gmres_restart, std::max(n, 1)), par);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    detail::TerminationScales term_scales;
+
+    f64 eta = ncg.eta0;
+    f64 Fnorm_prev = 0.0;
+    f64 lin_res_norm = 0.0;
+
+    if (auto st = detail::init_equation_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            F,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, F.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 Fnorm = detail::par_norm(F, par);
+
+        if (auto st = detail::pre_step_checks_equation(f, Fnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        if (k > 0) { // forcing term
+            eta = detail::forcing_term(
+                ncg,
+                eta,
+                Fnorm,
+                Fnorm_prev,
+                lin_res_norm,
+                detail::res_tol_effective(opt, &term_scales)
+            );
+        } // end forcing term
+
+        f64 gmres_res = 0.0;
+        i32 gmres_iters = 0;
+        const bool ok = detail::gmres_direction(
+            oracle,
+            opt,
+            res.x,
+            F,
+            eta * Fnorm,
+            p,
+            Jp,
+            work,
+            gmres_res,
+            gmres_iters
+        );
+        res.cg_iters += gmres_iters;
+        if (!ok) { // J v product failed
+            res.status
+                = oracle.any_limit_reached() ? Status::max_evals : Status::eval_failed;
+            break;
+        }
+
+        const f64 slope = detail::par_dot(F, Jp, par);
+        const f64 pp = detail::par_squared_norm(p, par);
+        if (!(slope < 0.0) || !(pp > 0.0)) { // GMRES made no progress
+            res.status = Status::linear_solve_failed;
+            break;
+        }
+        detail::par_scale(slope / pp, p, gp, par);
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = slope;
+        }
+
+        const detail::StepStatus step_status = detail::run_step(
+            oracle,
+            opt,
+            step_strategy,
+            res.x,
+            f,
+            gp,
+            p,
+            alpha,
+            x_next,
+            f_next
+        );
+        if (step_status != detail::StepStatus::accepted) {
+            res.status = detail::to_status(step_status);
+            break;
+        }
+
+        if (ncg.forcing == ForcingTerm::ew_choice1) {
+            detail::par_lincomb(1.0, F, alpha, Jp, lin_res, par);
+            lin_res_norm = detail::par_norm(lin_res, par);
+        }
+        Fnorm_prev = Fnorm;
+
+        const f64 f_prev = f;
+        const f64 step_norm = detail::par_distance(x_next, res.x, par);
+        if (auto st = detail::post_accept_equation_common(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                F,
+                x_next,
+                f_next,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+    } // end iteration
+    detail::finalize_common(res, oracle, f, F.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj, typename StepStrategy>
+Result newton_krylov(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    static_assert(
+        is_least_squares_v<Obj>,
+        "newton_krylov: Obj needs residual(x, F) and num_residuals()"
+    );
+    return detail::newton_krylov_impl(obj, x0, opt, step_strategy, on_iter, should_stop);
+}
+
+// overload default Armijo
+template <typename Obj>
+Result newton_krylov(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return newton_krylov(obj, x0, opt, Armijo{}, on_iter, should_stop);
+}
+
+} // namespace sOPT
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/problem/traits.hpp"
+#include "sOPT/step_size/interpolated/wolfe_interp.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sOPT {
+// Nonlinear conjugate gradient (line-search)
+// ref: nocedal2006numerical pp.121-133, hager2006survey, hager2005new
+//
+// \begin{aligned}
+// x_{k+1} &= x_k + \alpha_k p_k, \quad y_k = g_{k+1} - g_k, \quad z_k = M^{-1} g_k \\
+// p_{k+1} &= -z_{k+1} + \beta_k p_k, \quad p_0 = -z_0
+// \end{aligned}
+//
+// with beta_k from opt.ncg.beta:
+//
+// \begin{aligned}
+// \text{FR:}\ \beta_k &= \frac{g_{k+1}^T z_{k+1}}{g_k^T z_k} \qquad
+// \text{PR+:}\ \beta_k = \max\Big(0, \frac{z_{k+1}^T y_k}{g_k^T z_k}\Big) \qquad
+// \text{HS:}\ \beta_k = \frac{z_{k+1}^T y_k}{p_k^T y_k} \\
+// \text{DY:}\ \beta_k &= \frac{g_{k+1}^T z_{k+1}}{p_k^T y_k} \qquad
+// \text{HZ:}\ \beta_k = \max\Big(\frac{z_{k+1}^T y_k}{p_k^T y_k}
+//     - 2 \frac{y_k^T M^{-1} y_k}{p_k^T y_k} \frac{p_k^T g_{k+1}}{p_k^T y_k},\
+//     \frac{-1}{\|p_k\| \min(\eta, \|g_k\|)}\Big)
+// \end{aligned}
+//
+// M = I unless the objective has precondition(x, r, z) (has_precondition_v) and
+// opt.ncg.precondition is set. The iteration restarts with p_{k+1} = -z_{k+1} every
+// restart_iters steps, when |g_{k+1}^T g_k| >= restart_tol ||g_{k+1}||^2 (Powell),
+// when p_k^T y_k <= 0 (HS, DY, HZ), and whenever p_{k+1} is not a descent direction.
+//
+// The step strategy gets tau_k p_k with tau_0 = 1 and
+// tau_k = \alpha_{k-1} tau_{k-1} g_{k-1}^T p_{k-1} / g_k^T p_k (nocedal2006numerical
+// p.59), so a unit trial step repeats the previous first-order change in f. Memory is
+// O(n): x, x_next, g, g_k (then y_k), p, plus z with a preconditioner. The line
+// search runs with c2 = opt.ncg.ls_c2 (0.1): FR and PR+ need a strong Wolfe search
+// with c2 < 1/2, and the quasi-Newton default 0.9 is too loose for conjugacy. HZ
+// gives g^T p <= -7/8 ||g||^2 (M = I) under any line search. A failed line search
+// is retried once from p = -z with tau = 1 before the solver stops.
+template <typename Obj, typename StepStrategy>
+Result nonlinear_cg(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const StepStrategy& step_strategy,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const NonlinearCGOptions& ncg = opt.ncg;
+    const bool precond = has_precondition_v<Obj> && ncg.precondition;
+    vecXd g(n); // gradient
+    vecXd y(n); // g_k, then y_k = g_{k+1} - g_k
+    vecXd p(n); // tau_k p_k (scaled CG direction)
+    vecXd x_next(n);
+    vecXd z; // M^{-1} g (preconditioned only)
+    for (vecXd* v : {&g, &y, &p, &x_next}) detail::par_first_touch(*v, par);
+    if (precond) {
+        z.resize(n);
+        detail::par_first_touch(z, par);
+    }
+    const vecXd& zr = precond ? z : g;
+    Options opt_ls; // opt with ls.c2 = ncg.ls_c2, for the step strategy
+    if (ncg.ls_c2 > 0.0) {
+        opt_ls = opt;
+        opt_ls.ls.c2 = ncg.ls_c2;
+    }
+    const Options& ls = (ncg.ls_c2 > 0.0) ? opt_ls : opt;
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 alpha = 0.0;
+    detail::TerminationScales term_scales;
+
+    const i32 restart_iters = (ncg.restart_iters > 0) ? ncg.restart_iters : n;
+    i32 since_restart = 0;
+    f64 tau = 1.0;       // scale of p
+    f64 gTp = 0.0;       // g_k^T p (scaled)
+    f64 gz_prev = 0.0;   // g_k^T z_k
+    f64 gnorm_prev = 0.0;
+    f64 pnorm = 0.0;     // ||p|| (scaled)
+    bool retry = false;  // last line search failed: p = -z, tau = 1
+
+    if (auto st = detail::init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = detail::par_norm(g, par);
+
+        if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        }
+
+        f64 gz = gnorm * gnorm; // g^T z
+        if (precond) {
+            if (!oracle.try_precondition(res.x, g, z)) {
+                res.status = Status::eval_failed;
+                break;
+            }
+            gz = detail::par_dot(g, z, par);
+            if (!(gz > 0.0)) { // M not SPD at x: steepest descent for this step
+                detail::par_scale(1.0, g, z, par);
+                gz = gnorm * gnorm;
+            }
+        }
+
+        // beta_k, in terms of the unscaled p_k = p / tau
+        bool restart = (k == 0) || retry || (since_restart >= restart_iters);
+        f64 beta = 0.0;
+        f64 gTp_old = 0.0; // g_{k+1}^T p_k (scaled)
+        if (!restart) {
+            gTp_old = detail::par_dot(g, p, par);
+            const f64 zy = detail::par_dot(zr, y, par);
+            const f64 gy = precond ? detail::par_dot(g, y, par) : zy;
+            const f64 pTy = (gTp_old - gTp) / tau; // (g_{k+1} - g_k)^T p_k
+            restart = ncg.restart_tol > 0.0
+                && std::abs(gnorm * gnorm - gy) >= ncg.restart_tol * gnorm * gnorm;
+
+            switch (ncg.beta) {
+            case NonlinearCGBeta::fletcher_reeves: beta = gz / gz_prev; break;
+            case NonlinearCGBeta::polak_ribiere_plus:
+                beta = std::max(0.0, zy / gz_prev);
+                break;
+            case NonlinearCGBeta::hestenes_stiefel: beta = zy / pTy; break;
+            case NonlinearCGBeta::dai_yuan: beta = gz / pTy; break;
+            case NonlinearCGBeta::hager_zhang: {
+                f64 yMy = 0.0; // y^T M^{-1} y, x_next as scratch
+                if (precond) {
+                    if (!oracle.try_precondition(res.x, y, x_next)) {
+                        res.status = Status::eval_failed;
+                        break;
+                    }
+                    yMy = detail::par_dot(y, x_next, par);
+                } else {
+                    yMy = detail::par_squared_norm(y, par);
+                }
+                beta = (zy - 2.0 * yMy * (gTp_old / tau) / pTy) / pTy;
+                const f64 beta_min
+                    = -1.0 / ((pnorm / tau) * std::min(ncg.hz_eta, gnorm_prev));
+                beta = std::max(beta, beta_min);
+                break;
+            }
+            }
+            if (res.status == Status::eval_failed) break;
+            const bool needs_curvature = ncg.beta != NonlinearCGBeta::fletcher_reeves
+                && ncg.beta != NonlinearCGBeta::polak_ribiere_plus;
+            if (needs_curvature && !(pTy > 0.0)) restart = true;
+            if (!isfinite(beta)) restart = true;
+        }
+
+        // g_{k+1}^T p_{k+1} before forming p_{k+1}
+        f64 gTd = restart ? -gz : (-gz + (beta / tau) * gTp_old);
+        if (!(gTd < 0.0)) { // not a descent direction
+            restart = true;
+            gTd = -gz;
+        }
+        if (restart) since_restart = 0;
+
+        // tau_{k+1} = alpha_k tau_k g_k^T p_k / g_{k+1}^T p_{k+1}
+        f64 tau_next = (k == 0 || retry) ? 1.0 : alpha * gTp / gTd;
+        if (!isfinite(tau_next) || !(tau_next > 0.0)) tau_next = 1.0;
+
+        if (restart) {
+            detail::par_scale(-tau_next, zr, p, par);
+        } else {
+            detail::par_lincomb(-tau_next, zr, tau_next * beta / tau, p, p, par);
+        }
+        tau = tau_next;
+        gTp = tau * gTd;
+        gz_prev = gz;
+        gnorm_prev = gnorm;
+        pnorm = detail::par_norm(p, par);
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = gTp;
+        }
+
+        const detail::StepStatus step_status = detail::run_step(
+            oracle,
+            ls,
+            step_strategy,
+            res.x,
+            f,
+            g,
+            p,
+            alpha,
+            x_next,
+            f_next,
+            false // TryFull's Armijo-only unit step breaks conjugacy
+        );
+        const bool fresh = retry;
+        retry = false;
+        if (step_status == detail::StepStatus::line_search_failed && !fresh) {
+            retry = true; // tau_k too small for opt.ls.alpha_max, or p_k poor
+            continue;
+        }
+        if (step_status != detail::StepStatus::accepted) {
+            res.status = detail::to_status(step_status);
+            break;
+        }
+
+        detail::par_scale(1.0, g, y, par); // g_k
+        const f64 f_prev = f;
+        const f64 step_norm = alpha * pnorm; // ||x_{k+1} - x_k||
+        if (auto st = detail::post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                alpha,
+                step_norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+        detail::par_lincomb(1.0, g, -1.0, y, y, par);
+        ++since_restart;
+    } // end iteration
+    detail::finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+
+// overload default Strong Wolfe (interpolating zoom: CG wants accurate steps)
+template <typename Obj>
+Result nonlinear_cg(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return nonlinear_cg(obj, x0, opt, WolfeStrongInterp{}, on_iter, should_stop);
+}
+
+} // namespace sOPT
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/algorithms/detail/packed_sym.hpp"
 #include "sOPT/algorithms/detail/solver_common.hpp"
 #include "sOPT/core/callback.hpp"
 #include "sOPT/core/math.hpp"
@@ -54,8 +55,8 @@ Result sr1(
     f64 alpha = 0.0;
     f64 last_ys = qNaN<f64>;
     f64 last_ys_cos = qNaN<f64>;
-    matXd B(n, n);
-    B.setIdentity();
+    detail::PackedSym B(n); // packed lower triangle
+    B.set_identity();
 
     detail::TerminationScales term_scales;
 
@@ -83,9 +84,9 @@ Result sr1(
             break;
         }
 
-        p.noalias() = -(B * g);
+        B.multiply(g, p, -1.0);
         if (g.dot(p) >= 0.0) {
-            B.setIdentity();
+            B.set_identity();
             p.noalias() = -g;
         }
 
@@ -160,7 +161,7 @@ Result sr1(
             }
         }
 
-        By.noalias() = B.selfadjointView<Eigen::Lower>() * y;
+        B.multiply(y, By);
         u.noalias() = s - By;
         const f64 uy = u.dot(y);
 
@@ -168,8 +169,7 @@ Result sr1(
         const f64 guard = r * u.norm() * y.norm();
         if (isfinite(uy) && isfinite(guard) && std::abs(uy) >= guard
             && std::abs(uy) > 0.0) {
-            B.noalias() += (u * u.transpose()) / uy;
-            B = B.selfadjointView<eLo>();
+            B.rank1_update(1.0 / uy, u); // B += u u^T / uy
         } else {
             // skip unstable SR1 update when denominator is too small
         }
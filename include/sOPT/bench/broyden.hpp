@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/bench/sparse_hessian.hpp"
 #include "sOPT/core/math.hpp"
 #include "sOPT/core/vecdefs.hpp"
 
@@ -58,6 +59,46 @@ struct BroydenGenTridiag {
         }
     }
 
+    // lower triangle, pentadiagonal pattern
+    //   \nabla^2 |q|^p = p (p-1) |q|^{p-2} \nabla q \nabla q^T
+    //                    + p sign(q) |q|^{p-1} \nabla^2 q
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+
+        svec<tripletd> T;
+        T.reserve(6 * n);
+        const f64 p = 7. / 3.;
+        for (i32 ii = 1; ii <= n; ++ii) {
+            const i32 i = ii - 1;
+
+            const f64 xim1 = (ii == 1) ? 0. : x(i - 1);
+            const f64 xi = x(i);
+            const f64 xip1 = (ii == n) ? 0. : x(i + 1);
+
+            const f64 q = (3. - 2 * xi) * xi - xim1 - xip1 + 1.;
+            const f64 aq = std::abs(q);
+            const f64 w = p * sign(q) * std::pow(aq, p - 1.);
+            const f64 w2 = p * (p - 1.) * std::pow(aq, p - 2.);
+
+            i32 idx[3];
+            f64 dq[3];
+            i32 m = 0;
+            if (ii > 1) {
+                idx[m] = i - 1;
+                dq[m++] = -1.;
+            }
+            idx[m] = i;
+            dq[m++] = 3. - 4. * xi;
+            if (ii < n) {
+                idx[m] = i + 1;
+                dq[m++] = -1.;
+            }
+            detail::sym_add_outer(T, w2, idx, dq, m);
+            detail::sym_add(T, i, i, -4. * w);
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) { return vecXd::Constant(n, -1.); }
 
     bool check_x(ecref<vecXd> x) {
@@ -149,6 +190,45 @@ struct BroydenGenBanded {
         }
     }
 
+    // lower triangle, band of half-width 6 (x_i couples to x_{i-5..i+1})
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+
+        svec<tripletd> T;
+        T.reserve(35 * n);
+        const f64 p = 7. / 3.;
+        for (i32 ii = 1; ii <= n; ii++) {
+            const i32 i = ii - 1;
+            const f64 xi = x(i);
+
+            i32 idx[7];
+            f64 ds[7];
+            i32 m = 0;
+            idx[m] = i;
+            ds[m++] = 2. + 15. * xi * xi;
+            f64 si = (2. + 5. * xi * xi) * xi + 1.;
+
+            const i32 lo = std::max(1, ii - 5);
+            const i32 hi = std::min(n, ii + 1);
+            for (i32 jj = lo; jj <= hi; jj++) {
+                if (jj == ii) continue;
+                const i32 j = jj - 1;
+                const f64 xj = x(j);
+                si += (1. + xj) * xj;
+                idx[m] = j;
+                ds[m++] = 1. + 2. * xj;
+            }
+
+            const f64 asi = std::abs(si);
+            const f64 wi = p * sign(si) * std::pow(asi, p - 1.);
+            const f64 w2 = p * (p - 1.) * std::pow(asi, p - 2.);
+            detail::sym_add_outer(T, w2, idx, ds, m);
+            detail::sym_add(T, i, i, wi * 30. * xi);
+            for (i32 t = 1; t < m; t++) detail::sym_add(T, idx[t], idx[t], 2. * wi);
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) {
         // return -vecXd::Ones(n);
         return vecXd::Constant(n, -1.);
@@ -224,6 +304,53 @@ struct BroydenGen7Diag {
         }
     }
 
+    // lower triangle, pattern: pentadiagonal plus the (i + n/2, i) coupling
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+
+        svec<tripletd> T;
+        T.reserve(8 * n);
+        const f64 p = 7. / 3.;
+        for (i32 ii = 1; ii <= n; ++ii) {
+            const i32 i = ii - 1;
+
+            const f64 xim1 = (ii == 1) ? 0. : x(i - 1);
+            const f64 xi = x(i);
+            const f64 xip1 = (ii == n) ? 0. : x(i + 1);
+
+            const f64 q = (3. - 2 * xi) * xi - xim1 - xip1 + 1.;
+            const f64 aq = std::abs(q);
+            const f64 w = p * sign(q) * std::pow(aq, p - 1.);
+            const f64 w2 = p * (p - 1.) * std::pow(aq, p - 2.);
+
+            i32 idx[3];
+            f64 dq[3];
+            i32 m = 0;
+            if (ii > 1) {
+                idx[m] = i - 1;
+                dq[m++] = -1.;
+            }
+            idx[m] = i;
+            dq[m++] = 3. - 4. * xi;
+            if (ii < n) {
+                idx[m] = i + 1;
+                dq[m++] = -1.;
+            }
+            detail::sym_add_outer(T, w2, idx, dq, m);
+            detail::sym_add(T, i, i, -4. * w);
+
+            if (ii <= n / 2) {
+                const i32 j = i + n / 2;
+                const f64 r = xi + x(j);
+                const f64 wr2 = p * (p - 1.) * std::pow(std::abs(r), p - 2.);
+                const i32 idr[2] = {i, j};
+                const f64 dr[2] = {1., 1.};
+                detail::sym_add_outer(T, wr2, idr, dr, 2);
+            }
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) { return vecXd::Constant(n, -1.); }
 
     bool check_x(ecref<vecXd> x) {
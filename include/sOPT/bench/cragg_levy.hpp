@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/bench/sparse_hessian.hpp"
 #include "sOPT/core/math.hpp"
 #include "sOPT/core/vecdefs.hpp"
 
@@ -73,6 +74,49 @@ struct CraggLevyChained {
         }
     }
 
+    // lower triangle, pattern: blocks of 4 overlapping by 2
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+
+        svec<tripletd> T;
+        const i32 k = (n - 2) / 2;
+        T.reserve(14 * k);
+        for (i32 jj = 1; jj <= k; ++jj) {
+            const i32 ii = 2 * jj;
+            const i32 i = ii - 1;
+
+            const f64 xim1 = x(i - 1);
+            const f64 xi = x(i);
+            const f64 xip1 = x(i + 1);
+            const f64 xip2 = x(i + 2);
+
+            const f64 e = std::exp(xim1);
+            const f64 t1 = e - xi;
+            const f64 t2 = xi - xip1;
+            const f64 tant3 = std::tan(xip1 - xip2);
+            const f64 tant3_2 = tant3 * tant3;
+            const f64 sect3_2 = 1. + tant3_2;
+
+            const i32 idx[4] = {i - 1, i, i + 1, i + 2};
+            const f64 d1[4] = {e, -1., 0., 0.};  // grad t1
+            const f64 d2[4] = {0., 1., -1., 0.}; // grad t2
+            const f64 d3[4] = {0., 0., 1., -1.}; // grad t3
+            detail::sym_add_outer(T, 12. * t1 * t1, idx, d1, 4);
+            detail::sym_add_outer(T, 3000. * pow_Ti(t2, 4), idx, d2, 4);
+            detail::sym_add_outer(
+                T,
+                (12. * tant3_2 + 20. * tant3_2 * tant3_2) * sect3_2,
+                idx,
+                d3,
+                4
+            );
+            const f64 haa = 4. * pow_Ti(t1, 3) * e + 56. * pow_Ti(xim1, 6);
+            detail::sym_add(T, i - 1, i - 1, haa);
+            detail::sym_add(T, i + 2, i + 2, 2.);
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) {
         vecXd x(n);
 
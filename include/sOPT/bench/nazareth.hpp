@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/bench/sparse_hessian.hpp"
 #include "sOPT/core/math.hpp"
 #include "sOPT/core/vecdefs.hpp"
 
@@ -134,6 +135,55 @@ struct NazarethMod {
         g *= 2. / f64(n);
     }
 
+    // lower triangle, pattern: band of half-width 4 plus couplings near +-n/2
+    //   H = (2/n) \sum_i [\nabla s_i \nabla s_i^T + s_i \nabla^2 s_i]
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+
+        svec<tripletd> T;
+        T.reserve(29 * n);
+        const i32 d = n / 2;
+        const f64 w = 2. / f64(n);
+
+        for (i32 ii = 1; ii <= n; ii++) {
+            // variables of term i: x_{i-2..i+2} and x_{i+-d} (1-based)
+            i32 jjs[7];
+            i32 m = 0;
+            const i32 lo = std::max(1, ii - 2);
+            const i32 hi = std::min(n, ii + 2);
+            for (i32 jj = lo; jj <= hi; jj++) jjs[m++] = jj;
+            if (d > 2) {
+                if (ii + d <= n) jjs[m++] = ii + d;
+                if (ii - d >= 1) jjs[m++] = ii - d;
+            }
+
+            i32 idx[7];
+            f64 ds[7];
+            f64 si = f64(n) + f64(ii);
+            for (i32 t = 0; t < m; t++) {
+                const i32 jj = jjs[t];
+                const i32 j = jj - 1;
+                const f64 a = 5. * (1. + f64(ii % 5) + f64(jj % 5));
+                const f64 b = f64(ii + jj) * 0.1;
+                const f64 xj = x(j);
+                si -= a * std::sin(xj) + b * std::cos(xj);
+                idx[t] = j;
+                ds[t] = -(a * std::cos(xj) - b * std::sin(xj));
+            }
+
+            detail::sym_add_outer(T, w, idx, ds, m);
+            for (i32 t = 0; t < m; t++) {
+                const i32 jj = jjs[t];
+                const f64 a = 5. * (1. + f64(ii % 5) + f64(jj % 5));
+                const f64 b = f64(ii + jj) * 0.1;
+                const f64 xj = x(jj - 1);
+                const f64 d2 = a * std::sin(xj) + b * std::cos(xj); // d^2 s_i / dx_j^2
+                detail::sym_add(T, jj - 1, jj - 1, w * si * d2);
+            }
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) { return vecXd::Constant(n, 1. / f64(n)); }
 
     bool check_x(ecref<vecXd> x) {
@@ -235,6 +285,37 @@ struct NazarethModAlt {
         g *= 1. / f64(n);
     }
 
+    // separable: diagonal pattern
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+
+        vecXd h(n);
+        for (i32 ii = 1; ii <= n; ii++) h(ii - 1) = f64(ii) * std::cos(x(ii - 1));
+
+        const i32 d = n / 2;
+        auto add = [&](i32 ii, i32 jj) {
+            const i32 j = jj - 1;
+            const f64 a = 5. * (1. + f64(ii % 5) + f64(jj % 5));
+            const f64 b = f64(ii + jj) * 0.1;
+            const f64 xj = x(j);
+            h(j) -= a * std::sin(xj) + b * std::cos(xj);
+        };
+        for (i32 ii = 1; ii <= n; ii++) {
+            const i32 lo = std::max(1, ii - 2);
+            const i32 hi = std::min(n, ii + 2);
+            for (i32 jj = lo; jj <= hi; jj++) add(ii, jj);
+            if (d > 2) {
+                if (ii + d <= n) add(ii, ii + d);
+                if (ii - d >= 1) add(ii, ii - d);
+            }
+        }
+
+        svec<tripletd> T;
+        T.reserve(n);
+        for (i32 i = 0; i < n; i++) T.emplace_back(i, i, h(i) / f64(n));
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) { return vecXd::Constant(n, 1. / f64(n)); }
 
     bool check_x(ecref<vecXd> x) {
@@ -359,6 +440,39 @@ struct TointTrig {
         g *= 1. / f64(n);
     }
 
+    // lower triangle, pattern: band of half-width 2 plus the (i +- n/2, i) couplings
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+
+        svec<tripletd> T;
+        T.reserve(21 * n);
+        const i32 d = n / 2;
+
+        auto add = [&](i32 ii, i32 jj) {
+            const i32 i = ii - 1;
+            const i32 j = jj - 1;
+            const f64 ci = 1. + f64(ii) * 0.1;
+            const f64 cj = 1. + f64(jj) * 0.1;
+            const f64 a = 5. * (1. + f64(ii % 5) + f64(jj % 5));
+            const f64 b = f64(ii + jj) * 0.1;
+            const f64 arg = b + ci * x(i) + cj * x(j);
+
+            const i32 idx[2] = {i, j};
+            const f64 c[2] = {ci, cj};
+            detail::sym_add_outer(T, -a * std::sin(arg) / f64(n), idx, c, 2);
+        };
+        for (i32 ii = 1; ii <= n; ++ii) {
+            const i32 lo = std::max(1, ii - 2);
+            const i32 hi = std::min(n, ii + 2);
+            for (i32 jj = lo; jj <= hi; ++jj) add(ii, jj);
+            if (d > 2) {
+                if (ii + d <= n) add(ii, ii + d);
+                if (ii - d >= 1) add(ii, ii - d);
+            }
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) { return vecXd::Constant(n, 1.); }
 
     bool check_x(ecref<vecXd> x) {
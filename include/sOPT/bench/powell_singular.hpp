@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/bench/sparse_hessian.hpp"
 #include "sOPT/core/vecdefs.hpp"
 #include <cassert>
 
@@ -68,6 +69,36 @@ struct PowellSingularChained {
         }
     }
 
+    // lower triangle, pattern: dense 4 x 4 blocks overlapping by 2
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+        assert(n >= 4 && n % 4 == 0);
+
+        svec<tripletd> T;
+        i32 k = (n - 2) / 2;
+        T.reserve(40 * k);
+        for (i32 jj = 1; jj <= k; jj++) {
+            const i32 ii = 2 * jj;
+            const i32 i = ii - 1;
+
+            const f64 xi = x(i);
+            const f64 xip1 = x(i + 1);
+            const f64 t3 = xi - 2. * xip1;
+            const f64 t4 = x(i - 1) - x(i + 2);
+
+            const i32 idx[4] = {i - 1, i, i + 1, i + 2};
+            const f64 d1[4] = {1., 10., 0., 0.}; // grad t1
+            const f64 d2[4] = {0., 0., 1., -1.}; // grad t2
+            const f64 d3[4] = {0., 1., -2., 0.}; // grad t3
+            const f64 d4[4] = {1., 0., 0., -1.}; // grad t4
+            detail::sym_add_outer(T, 2., idx, d1, 4);
+            detail::sym_add_outer(T, 10., idx, d2, 4);
+            detail::sym_add_outer(T, 12. * t3 * t3, idx, d3, 4);
+            detail::sym_add_outer(T, 120. * t4 * t4, idx, d4, 4);
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) {
         assert(n >= 4 && n % 4 == 0);
         vecXd x(n);
@@ -63,6 +63,23 @@ struct QuadraticSPD {
 
     void hessian(ecref<vecXd>, eref<matXd> H) const { H = A; }
 
+    void hessian_vector(ecref<vecXd>, ecref<vecXd> v, eref<vecXd> Hv) const {
+        Hv.noalias() = A * v;
+    }
+
+    // ray restriction (see has_ray_func):
+    //   f(x + a p) = f(x) + a (A x - b)^T p + 0.5 a^2 p^T A p
+    // two matvecs per ray, O(1) per line-search probe
+    void prepare_ray(ecref<vecXd> x, ecref<vecXd> p) const {
+        ray_tmp.noalias() = A * x;
+        ray_f0 = 0.5 * x.dot(ray_tmp) - b.dot(x);
+        ray_d0 = p.dot(ray_tmp) - b.dot(p);
+        ray_tmp.noalias() = A * p;
+        ray_pAp = p.dot(ray_tmp);
+    }
+    f64 func_along(f64 a) const { return ray_f0 + a * ray_d0 + 0.5 * a * a * ray_pAp; }
+    f64 dfunc_along(f64 a) const { return ray_d0 + a * ray_pAp; }
+
     bool check_x(ecref<vecXd> x) {
         const i32 n = static_cast<i32>(x.size());
         return (n >= 1);
@@ -70,6 +87,12 @@ struct QuadraticSPD {
     void check_assert(ecref<vecXd> x) {
         assert(check_x(x));
     }
+
+  private:
+    mutable f64 ray_f0 = 0.0;
+    mutable f64 ray_d0 = 0.0;
+    mutable f64 ray_pAp = 0.0;
+    mutable vecXd ray_tmp;
 };
 
 static vecXd x0_quadratic(i32 n) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/bench/sparse_hessian.hpp"
 #include "sOPT/core/vecdefs.hpp"
 #include <cassert>
 
@@ -44,6 +45,25 @@ struct RosenbrockChained {
         }
     }
 
+    // lower triangle, tridiagonal pattern
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+        assert(n >= 2);
+
+        svec<tripletd> T;
+        T.reserve(3 * (n - 1));
+        for (i32 ii = 2; ii <= n; ii++) {
+            i32 i = ii - 1;
+
+            const f64 xim1 = x(i - 1);
+            const f64 xi = x(i);
+            detail::sym_add(T, i - 1, i - 1, 1200. * xim1 * xim1 - 400. * xi + 2.);
+            detail::sym_add(T, i, i - 1, -400. * xim1);
+            detail::sym_add(T, i, i, 200.);
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) {
         vecXd x(n);
         for (i32 ii = 1; ii <= n; ii++) {
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "sOPT/core/typedefs.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <algorithm>
+
+namespace sOPT::detail {
+
+// Triplet assembly for the bench hessian_sparse() methods. Only the lower triangle
+// is stored; setFromTriplets sums duplicates. Entries are emitted even when their
+// value is zero so the sparsity pattern does not depend on x.
+
+// H(i, j) += v  (and H(j, i) by symmetry)
+inline void sym_add(svec<tripletd>& T, i32 i, i32 j, f64 v) {
+    T.emplace_back(std::max(i, j), std::min(i, j), v);
+}
+
+// H += w u u^T over the variables idx[0..m). Repeated indices are allowed: a
+// (p, q) pair landing on one entry counts both H(i, j) and H(j, i).
+inline void sym_add_outer(svec<tripletd>& T, f64 w, const i32* idx, const f64* u, i32 m) {
+    for (i32 p = 0; p < m; p++) {
+        for (i32 q = 0; q <= p; q++) {
+            const f64 v = w * u[p] * u[q];
+            sym_add(T, idx[p], idx[q], (p != q && idx[p] == idx[q]) ? 2.0 * v : v);
+        }
+    }
+}
+
+inline void assemble_lower(i32 n, const svec<tripletd>& T, spmatXd& H) {
+    H.resize(n, n);
+    H.setFromTriplets(T.begin(), T.end());
+    H.makeCompressed();
+}
+
+} // namespace sOPT::detail
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sOPT/bench/sparse_hessian.hpp"
 #include "sOPT/core/vecdefs.hpp"
 #include <cassert>
 
@@ -69,6 +70,34 @@ struct WoodNDChained {
         }
     }
 
+    // lower triangle, pattern: blocks of 4 overlapping by 2
+    void hessian_sparse(ecref<vecXd> x, spmatXd& H) const {
+        const i32 n = static_cast<i32>(x.size());
+        assert(n % 2 == 0 && n >= 4);
+
+        svec<tripletd> T;
+        const i32 k = (n - 2) / 2;
+        T.reserve(7 * k);
+        for (i32 jj = 1; jj <= k; ++jj) {
+            const i32 ii = 2 * jj;
+            const i32 i = ii - 1;
+
+            const f64 xim1 = x(i - 1);
+            const f64 xi = x(i);
+            const f64 xip1 = x(i + 1);
+            const f64 xip2 = x(i + 2);
+
+            detail::sym_add(T, i - 1, i - 1, 1200. * xim1 * xim1 - 400. * xi + 2.);
+            detail::sym_add(T, i, i - 1, -400. * xim1);
+            detail::sym_add(T, i, i, 220.2);
+            detail::sym_add(T, i + 1, i + 1, 1080. * xip1 * xip1 - 360. * xip2 + 2.);
+            detail::sym_add(T, i + 2, i + 1, -360. * xip1);
+            detail::sym_add(T, i + 2, i + 2, 200.2);
+            detail::sym_add(T, i + 2, i, 19.8);
+        }
+        detail::assemble_lower(n, T, H);
+    }
+
     vecXd x0(i32 n) {
         assert(n >= 4 && n % 2 == 0);
         vecXd x(n);
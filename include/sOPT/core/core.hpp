@@ -3,6 +3,7 @@
 #include "sOPT/core/math.hpp"
 #include "sOPT/core/options.hpp"
 #include "sOPT/core/options_validation.hpp"
+#include "sOPT/core/parallel.hpp"
 #include "sOPT/core/result.hpp"
 #include "sOPT/core/trace.hpp"
 #include "sOPT/core/typedefs.hpp"
@@ -10,4 +11,5 @@
 #include "sOPT/core/vecdefs.hpp"
 #include "sOPT/core/constants.hpp"
 #include "sOPT/core/callback.hpp"
-#include "sOPT/core/display.hpp"
\ No newline at end of file
+#include "sOPT/core/display.hpp"
+#include "sOPT/core/line_search_stats.hpp"
\ No newline at end of file
@@ -14,10 +14,21 @@ inline void print_sOPT_results(Result& res) {
     );
     std::println(
         "Evaluations:\nFunction evals: {}\nGradient evals: {}\nHessian evals: "
-        "{}",
+        "{}\nHessian-vector evals: {}",
         res.f_evals,
         res.g_evals,
-        res.h_evals
+        res.h_evals,
+        res.hv_evals
+    );
+    std::println(
+        "Line search: {} steps, {} phi / {} phi' probes, {} backtracks, "
+        "{} expansions, {} zoom iters",
+        res.ls.steps,
+        res.ls.totals.phi_evals,
+        res.ls.totals.dphi_evals,
+        res.ls.totals.backtracks,
+        res.ls.totals.expansions,
+        res.ls.totals.zoom_iters
     );
     std::println("gradient norm: {}", res.grad_norm);
     std::println("Optimal value x* = {}", res.x);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "sOPT/core/typedefs.hpp"
+
+namespace sOPT {
+
+// per-step line-search counters
+struct LineSearchStats {
+    i32 phi_evals = 0;         // phi(alpha) probes
+    i32 dphi_evals = 0;        // phi'(alpha) probes
+    i32 backtracks = 0;        // step reductions
+    i32 expansions = 0;        // step increases (bracketing)
+    i32 zoom_iters = 0;        // zoom/sectioning iterations
+    i32 full_step_rejects = 0; // TryFull alpha = 1 rejections
+
+    LineSearchStats& operator+=(const LineSearchStats& o) {
+        phi_evals += o.phi_evals;
+        dphi_evals += o.dphi_evals;
+        backtracks += o.backtracks;
+        expansions += o.expansions;
+        zoom_iters += o.zoom_iters;
+        full_step_rejects += o.full_step_rejects;
+        return *this;
+    }
+};
+
+// run-level aggregate of LineSearchStats
+struct LineSearchSummary {
+    i32 steps = 0; // step attempts (accepted or not)
+    LineSearchStats totals;
+    svec<i32> phi_hist;       // phi_hist[k]: steps with k phi probes
+    svec<i32> dphi_hist;      // dphi_hist[k]: steps with k phi' probes
+    svec<i32> backtrack_hist; // backtrack_hist[k]: steps with k backtracks
+
+    void record(const LineSearchStats& s) {
+        ++steps;
+        totals += s;
+        hist_add_(phi_hist, s.phi_evals);
+        hist_add_(dphi_hist, s.dphi_evals);
+        hist_add_(backtrack_hist, s.backtracks);
+    }
+
+  private:
+    static void hist_add_(svec<i32>& hist, i32 k) {
+        if (k < 0) return;
+        if (static_cast<i32>(hist.size()) <= k) hist.resize(k + 1, 0);
+        ++hist[k];
+    }
+};
+
+} // namespace sOPT
@@ -4,6 +4,8 @@
 #include "sOPT/core/trace.hpp"
 #include "sOPT/core/typedefs.hpp"
 
+#include <string>
+
 namespace sOPT {
 
 // finite difference options
@@ -31,11 +33,13 @@ enum struct FallbackHv {
     fd_backward_2,
     fd_central_2
 };
+enum struct FallbackJac { fd_forward, fd_backward, fd_central };
 
 struct FDOptions {
     FallbackGrad fallback_grad = FallbackGrad::fd_central;
     FallbackHess fallback_hess = FallbackHess::fd_central;
     FallbackHv fallback_hv = FallbackHv::fd_central;
+    FallbackJac fallback_jac = FallbackJac::fd_forward; // residual Jacobian
     f64 eps = 1e-8; // TODO: separate gradient and hessian eps values
     f64 hv_eps = 1e-6;
 };
@@ -97,6 +101,124 @@ struct NewtonOptions {
     f64 damping0 = 1e-6;
     f64 damping_scale = 10.0;
     i32 damping_max_tries = 10;
+    bool modified_cholesky = false; // SE99 P (H + E) P^T = L D L^T, not damped LLT tries
+    f64 mc_min_pivot = 1e-8;        // modified Cholesky pivot floor, relative to max|H|
+    bool sparse = false; // sparse LDL^T path for has_hessian_sparse_v objectives
+};
+
+// newton_cg inner tolerance ||H p + g|| <= eta_k ||g|| (Eisenstat-Walker choices)
+enum class ForcingTerm : u8 { constant = 0, ew_choice1, ew_choice2 };
+
+struct NewtonCGOptions {
+    ForcingTerm forcing = ForcingTerm::ew_choice2;
+    f64 eta0 = 0.5;           // first forcing term (every term for constant)
+    f64 eta_max = 0.5;        // upper bound on eta_k
+    f64 ew_gamma = 0.9;       // choice 2: eta_k = gamma (|g_k| / |g_{k-1}|)^ew_alpha
+    f64 ew_alpha = 2.0;       // choice 2 exponent, 1 < alpha <= 2
+    i32 max_cg_iters = 0;     // 0 => n
+    bool precondition = true; // use obj.precondition when available
+};
+
+// trust-region radius management (trust_region/trust_region.hpp)
+struct TrustRegionOptions {
+    f64 delta0 = 1.0;        // initial radius
+    f64 delta_max = 1e8;     // radius cap
+    f64 eta_accept = 1e-4;   // accept the step if rho > eta_accept
+    f64 eta_shrink = 0.25;   // shrink if rho < eta_shrink
+    f64 eta_expand = 0.75;   // expand if rho > eta_expand and the step hit the boundary
+    f64 shrink = 0.25;       // delta <- shrink * ||p||
+    f64 expand = 2.0;        // delta <- min(expand * delta, delta_max)
+    i32 max_cg_iters = 0;    // SteihaugCG inner iterations (0 => n)
+    f64 ms_tol = 0.1;        // MoreSorensen: stop at | ||p|| - delta | <= ms_tol * delta
+    i32 ms_max_iters = 20;   // MoreSorensen factorizations per subproblem
+    i32 sr1_memory = 10;     // LSR1 stored pairs
+    f64 sr1_skip_tol = 1e-8; // LSR1 pair skip test (trust_region/lsr1.hpp)
+    f64 sr1_cond_max = 1e3;  // LSR1 drops oldest pairs while cond(N) > sr1_cond_max
+};
+
+// least-squares solvers (gauss_newton, levenberg_marquardt, gauss_newton_cg)
+struct LeastSquaresOptions {
+    f64 lm_tau = 1e-3;        // lambda_0 = tau * max_j (J^T J)_jj / D_jj^2
+    bool lm_scale = true;     // D_jj = running max of ||J e_j|| (More 1978), else D = I
+    f64 lm_eta_accept = 1e-4; // accept the LM step if rho > eta_accept
+    i32 cg_max_iters = 0;     // gauss_newton_cg inner CG iterations (0 => n)
+};
+
+// nonlinear equations F(x) = 0, F = residual, m = n (newton_krylov, broyden).
+// newton_krylov takes its forcing terms from opt.newton_cg.
+struct NonlinearEquationOptions {
+    f64 res_tol = tol_med;   // absolute: stop if ||F|| <= res_tol
+    f64 res_tol_rel = 0.0;   // relative: stop if ||F|| <= res_tol_rel * max(1, ||F_0||)
+    i32 gmres_restart = 30;  // newton_krylov Krylov basis size per GMRES cycle
+    i32 gmres_max_iters = 0; // newton_krylov GMRES iterations per step (0 => n)
+    i32 broyden_memory = 20; // broyden stored updates before a restart
+};
+
+// BarzilaiBorwein step (s = x_k - x_{k-1}, y = g_k - g_{k-1})
+enum class BBStep : u8 {
+    bb1 = 0,    // s^T s / s^T y (long)
+    bb2,        // s^T y / y^T y (short)
+    alternating // bb1 on odd iterations, bb2 on even ones
+};
+
+// gradient_descent with a line-search-free step rule (BarzilaiBorwein,
+// AdaptiveLipschitz)
+struct GradientDescentOptions {
+    BBStep bb = BBStep::alternating;
+    f64 alpha_init = 0.0;       // first step (0 => 1e-4 max(1, ||x_0||) / ||g_0||)
+    f64 alpha_min = 1e-20;      // step clamp
+    f64 alpha_max = 1e+20;
+    i32 nonmonotone_window = 0; // > 0: accept if f_{k+1} <= max of the last window f
+                                // + c1 alpha g^T p, else backtrack (evaluates f)
+};
+
+// accelerated_gradient momentum
+enum class AccelMethod : u8 {
+    nesterov = 0, // y_{k+1} = x_{k+1} + beta_k (x_{k+1} - x_k), gradient step from y
+    heavy_ball    // p_k = -g_k + beta p_{k-1} (Polyak)
+};
+
+// accelerated_gradient adaptive restart (beta_k = 0 for one step)
+enum class AccelRestart : u8 {
+    off = 0,
+    function, // f(x_{k+1}) > f(x_k) (nesterov only)
+    gradient  // grad f^T (x_{k+1} - x_k) > 0 (y_k: nesterov, x_{k+1}: heavy_ball)
+};
+
+struct AcceleratedGradientOptions {
+    AccelMethod method = AccelMethod::nesterov;
+    AccelRestart restart = AccelRestart::gradient;
+    f64 momentum = 0.0;    // fixed beta in [0, 1) (0 => nesterov: FISTA (t_k - 1) /
+                           // t_{k+1}, heavy_ball: 0.9)
+    f64 step_growth = 1.1; // first trial step alpha_{k-1} step_growth (0 => ls.alpha0)
+    f64 ls_c1 = 0.5;       // Armijo c1 in place of opt.ls.c1 (0 => opt.ls.c1)
+};
+
+// anderson / anderson_fixed_point (type-II Anderson mixing)
+struct AndersonOptions {
+    i32 memory = 5;             // stored (dx, dr) pairs (0 => base iteration only)
+    f64 mixing = 1.0;           // anderson_fixed_point: beta in x + beta F(x)
+    f64 regularization = 1e-10; // Tikhonov lambda = regularization ||dR||_F^2
+    f64 cond_max = 1e10;        // drop the oldest pairs while cond(R) > cond_max
+    bool safeguard = true;      // accept the mixed point only if it decreases f
+};
+
+// nonlinear_cg beta_k (p_{k+1} = -M^{-1} g_{k+1} + beta_k p_k)
+enum class NonlinearCGBeta : u8 {
+    fletcher_reeves = 0,
+    polak_ribiere_plus,
+    hestenes_stiefel,
+    dai_yuan,
+    hager_zhang
+};
+
+struct NonlinearCGOptions {
+    NonlinearCGBeta beta = NonlinearCGBeta::hager_zhang;
+    f64 restart_tol = 0.2;    // Powell: restart if |g_{k+1}^T g_k| >= tol ||g_{k+1}||^2
+    i32 restart_iters = 0;    // restart every restart_iters steps (0 => n)
+    f64 hz_eta = 0.01;        // hager_zhang: beta >= -1 / (||p_k|| min(hz_eta, ||g_k||))
+    f64 ls_c2 = 0.1;          // line-search c2 in place of opt.ls.c2 (0 => opt.ls.c2)
+    bool precondition = true; // use obj.precondition when available
 };
 
 struct LBFGSOptions {
@@ -104,6 +226,27 @@ struct LBFGSOptions {
     bool h0_auto_scale = true;
     f64 h0_scale_min = 1e-8;
     f64 h0_scale_max = 1e+8;
+    bool compact = false; // apply H_k in compact (Byrd-Nocedal-Schnabel) form
+    bool f32_history = false; // store S/Y in f32 (dot products still in f64)
+    std::string history_dir;  // non-empty: keep S/Y in a mapped temp file here
+};
+
+// shared by the quasi-Newton solvers (bfgs, lbfgs)
+struct QuasiNewtonOptions {
+    i32 harvest_pairs = 0;          // extra secant pairs per step from line-search trials
+    f64 harvest_indep_tol = 1e-2;   // reject trial pairs with |cos(s_t, s)| > 1 - tol
+};
+
+struct LowFiOptions {
+    f64 max_mismatch_rate = 0.5; // stop screening above this mismatch rate
+    i32 min_screens = 4;         // screens before the rate is trusted
+};
+
+// large-n vector kernels (core/parallel.hpp)
+struct ParallelOptions {
+    i32 threads = 1;        // 1 => serial Eigen kernels, 0 => hardware_concurrency
+    i64 min_n = 1ll << 17;  // parallel kernels only for n >= min_n
+    i64 chunk = 1ll << 15;  // fixed reduction chunk (results independent of threads)
 };
 
 struct Options {
@@ -117,11 +260,23 @@ struct Options {
     // Situational options
     LineSearchOptions ls;
     NewtonOptions newton;
+    NewtonCGOptions newton_cg;
+    TrustRegionOptions tr;
+    LeastSquaresOptions lsq;
+    NonlinearEquationOptions nleq;
+    GradientDescentOptions gd;
+    AcceleratedGradientOptions agd;
+    AndersonOptions anderson;
+    NonlinearCGOptions ncg;
     LBFGSOptions lbfgs;
+    QuasiNewtonOptions qn;
+    LowFiOptions lowfi;
+    ParallelOptions parallel;
 
     // Trace Options
     TraceLevel trace_level = TraceLevel::off;
     i32 trace_reserve = 0; // 0 => reserver max_iters + 1
+    bool trace_line_search = false; // per-iteration LineSearchStats in Trace
 
     bool validate_options = true; // set false if solver called multiple times (i.e. in
                                   // optimal control problems)
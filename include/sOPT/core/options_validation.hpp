@@ -30,10 +30,59 @@ enum class OptionsValidationError : u8 {
     newton_damping0_nonpositive,
     newton_damping_scale_nonpositive,
     newton_damping_max_tries_negative,
+    newton_mc_min_pivot_nonpositive,
+    newton_sparse_modified_cholesky,
+    newton_cg_eta0_out_of_range,
+    newton_cg_eta_max_out_of_range,
+    newton_cg_ew_gamma_out_of_range,
+    newton_cg_ew_alpha_out_of_range,
+    newton_cg_max_cg_iters_negative,
+    tr_delta0_nonpositive,
+    tr_delta_max_too_small,
+    tr_eta_out_of_range,
+    tr_shrink_out_of_range,
+    tr_expand_too_small,
+    tr_max_cg_iters_negative,
+    tr_ms_tol_out_of_range,
+    tr_ms_max_iters_nonpositive,
+    tr_sr1_memory_negative,
+    tr_sr1_skip_tol_out_of_range,
+    tr_sr1_cond_max_out_of_range,
+    lsq_lm_tau_nonpositive,
+    lsq_lm_eta_accept_out_of_range,
+    lsq_cg_max_iters_negative,
+    nleq_res_tol_negative,
+    nleq_res_tol_rel_negative,
+    nleq_gmres_restart_nonpositive,
+    nleq_gmres_max_iters_negative,
+    nleq_broyden_memory_negative,
+    gd_alpha_init_negative,
+    gd_alpha_min_nonpositive,
+    gd_alpha_bounds_invalid,
+    gd_nonmonotone_window_negative,
+    agd_momentum_out_of_range,
+    agd_step_growth_out_of_range,
+    agd_ls_c1_out_of_range,
+    agd_heavy_ball_function_restart,
+    anderson_memory_negative,
+    anderson_mixing_nonpositive,
+    anderson_regularization_negative,
+    anderson_cond_max_out_of_range,
+    ncg_restart_tol_negative,
+    ncg_restart_iters_negative,
+    ncg_hz_eta_nonpositive,
+    ncg_ls_c2_out_of_range,
     lbfgs_memory_negative,
     lbfgs_h0_scale_min_nonpositive,
     lbfgs_h0_scale_max_nonpositive,
     lbfgs_h0_scale_bounds_invalid,
+    lowfi_max_mismatch_rate_out_of_range,
+    lowfi_min_screens_negative,
+    parallel_threads_negative,
+    parallel_min_n_negative,
+    parallel_chunk_nonpositive,
+    qn_harvest_pairs_negative,
+    qn_harvest_indep_tol_out_of_range,
     diag_cond_power_iters_negative,
     diag_cond_eps_nonpositive,
 };
@@ -155,6 +204,273 @@ inline OptionsValidationResult validate_options(const Options& opt) {
             "newton.damping_max_tries must be >= 0"
         );
     }
+    if (!finite_pos(opt.newton.mc_min_pivot)) {
+        return options_invalid(
+            OptionsValidationError::newton_mc_min_pivot_nonpositive,
+            "newton.mc_min_pivot must be finite and > 0"
+        );
+    }
+    if (opt.newton.sparse && opt.newton.modified_cholesky) {
+        return options_invalid(
+            OptionsValidationError::newton_sparse_modified_cholesky,
+            "newton.modified_cholesky is dense-only; it cannot be used with newton.sparse"
+        );
+    }
+    if (!(isfinite(opt.newton_cg.eta0) && in_op(opt.newton_cg.eta0, 0.0, 1.0))) {
+        return options_invalid(
+            OptionsValidationError::newton_cg_eta0_out_of_range,
+            "newton_cg.eta0 must satisfy 0 < eta0 < 1"
+        );
+    }
+    if (!(isfinite(opt.newton_cg.eta_max) && opt.newton_cg.eta_max >= opt.newton_cg.eta0
+          && opt.newton_cg.eta_max < 1.0)) {
+        return options_invalid(
+            OptionsValidationError::newton_cg_eta_max_out_of_range,
+            "newton_cg.eta_max must satisfy eta0 <= eta_max < 1"
+        );
+    }
+    if (!(isfinite(opt.newton_cg.ew_gamma) && opt.newton_cg.ew_gamma > 0.0
+          && opt.newton_cg.ew_gamma <= 1.0)) {
+        return options_invalid(
+            OptionsValidationError::newton_cg_ew_gamma_out_of_range,
+            "newton_cg.ew_gamma must satisfy 0 < gamma <= 1"
+        );
+    }
+    if (!(isfinite(opt.newton_cg.ew_alpha) && opt.newton_cg.ew_alpha > 1.0
+          && opt.newton_cg.ew_alpha <= 2.0)) {
+        return options_invalid(
+            OptionsValidationError::newton_cg_ew_alpha_out_of_range,
+            "newton_cg.ew_alpha must satisfy 1 < alpha <= 2"
+        );
+    }
+    if (opt.newton_cg.max_cg_iters < 0) {
+        return options_invalid(
+            OptionsValidationError::newton_cg_max_cg_iters_negative,
+            "newton_cg.max_cg_iters must be >= 0"
+        );
+    }
+    if (!finite_pos(opt.tr.delta0)) {
+        return options_invalid(
+            OptionsValidationError::tr_delta0_nonpositive,
+            "tr.delta0 must be finite and > 0"
+        );
+    }
+    if (!(isfinite(opt.tr.delta_max) && opt.tr.delta_max >= opt.tr.delta0)) {
+        return options_invalid(
+            OptionsValidationError::tr_delta_max_too_small,
+            "tr.delta_max must be finite and >= tr.delta0"
+        );
+    }
+    if (!(isfinite(opt.tr.eta_accept) && isfinite(opt.tr.eta_expand)
+          && 0.0 <= opt.tr.eta_accept && opt.tr.eta_accept < opt.tr.eta_shrink
+          && opt.tr.eta_shrink < opt.tr.eta_expand && opt.tr.eta_expand < 1.0)) {
+        return options_invalid(
+            OptionsValidationError::tr_eta_out_of_range,
+            "tr etas must satisfy 0 <= eta_accept < eta_shrink < eta_expand < 1"
+        );
+    }
+    if (!(isfinite(opt.tr.shrink) && in_op(opt.tr.shrink, 0.0, 1.0))) {
+        return options_invalid(
+            OptionsValidationError::tr_shrink_out_of_range,
+            "tr.shrink must satisfy 0 < shrink < 1"
+        );
+    }
+    if (!(isfinite(opt.tr.expand) && opt.tr.expand > 1.0)) {
+        return options_invalid(
+            OptionsValidationError::tr_expand_too_small,
+            "tr.expand must be finite and > 1"
+        );
+    }
+    if (opt.tr.max_cg_iters < 0) {
+        return options_invalid(
+            OptionsValidationError::tr_max_cg_iters_negative,
+            "tr.max_cg_iters must be >= 0"
+        );
+    }
+    if (!(isfinite(opt.tr.ms_tol) && in_op(opt.tr.ms_tol, 0.0, 1.0))) {
+        return options_invalid(
+            OptionsValidationError::tr_ms_tol_out_of_range,
+            "tr.ms_tol must satisfy 0 < ms_tol < 1"
+        );
+    }
+    if (opt.tr.ms_max_iters <= 0) {
+        return options_invalid(
+            OptionsValidationError::tr_ms_max_iters_nonpositive,
+            "tr.ms_max_iters must be > 0"
+        );
+    }
+    if (opt.tr.sr1_memory < 0) {
+        return options_invalid(
+            OptionsValidationError::tr_sr1_memory_negative,
+            "tr.sr1_memory must be >= 0"
+        );
+    }
+    if (!(isfinite(opt.tr.sr1_skip_tol) && opt.tr.sr1_skip_tol >= 0.0
+          && opt.tr.sr1_skip_tol < 1.0)) {
+        return options_invalid(
+            OptionsValidationError::tr_sr1_skip_tol_out_of_range,
+            "tr.sr1_skip_tol must satisfy 0 <= sr1_skip_tol < 1"
+        );
+    }
+    if (!(isfinite(opt.tr.sr1_cond_max) && opt.tr.sr1_cond_max >= 1.0)) {
+        return options_invalid(
+            OptionsValidationError::tr_sr1_cond_max_out_of_range,
+            "tr.sr1_cond_max must be finite and >= 1"
+        );
+    }
+    if (!finite_pos(opt.lsq.lm_tau)) {
+        return options_invalid(
+            OptionsValidationError::lsq_lm_tau_nonpositive,
+            "lsq.lm_tau must be finite and > 0"
+        );
+    }
+    if (!(isfinite(opt.lsq.lm_eta_accept) && opt.lsq.lm_eta_accept >= 0.0
+          && opt.lsq.lm_eta_accept < 1.0)) {
+        return options_invalid(
+            OptionsValidationError::lsq_lm_eta_accept_out_of_range,
+            "lsq.lm_eta_accept must satisfy 0 <= eta_accept < 1"
+        );
+    }
+    if (opt.lsq.cg_max_iters < 0) {
+        return options_invalid(
+            OptionsValidationError::lsq_cg_max_iters_negative,
+            "lsq.cg_max_iters must be >= 0"
+        );
+    }
+    if (!finite_nonneg(opt.nleq.res_tol)) {
+        return options_invalid(
+            OptionsValidationError::nleq_res_tol_negative,
+            "nleq.res_tol must be finite and >= 0"
+        );
+    }
+    if (!finite_nonneg(opt.nleq.res_tol_rel)) {
+        return options_invalid(
+            OptionsValidationError::nleq_res_tol_rel_negative,
+            "nleq.res_tol_rel must be finite and >= 0"
+        );
+    }
+    if (opt.nleq.gmres_restart <= 0) {
+        return options_invalid(
+            OptionsValidationError::nleq_gmres_restart_nonpositive,
+            "nleq.gmres_restart must be > 0"
+        );
+    }
+    if (opt.nleq.gmres_max_iters < 0) {
+        return options_invalid(
+            OptionsValidationError::nleq_gmres_max_iters_negative,
+            "nleq.gmres_max_iters must be >= 0"
+        );
+    }
+    if (opt.nleq.broyden_memory < 0) {
+        return options_invalid(
+            OptionsValidationError::nleq_broyden_memory_negative,
+            "nleq.broyden_memory must be >= 0"
+        );
+    }
+
+    if (!finite_nonneg(opt.gd.alpha_init)) {
+        return options_invalid(
+            OptionsValidationError::gd_alpha_init_negative,
+            "gd.alpha_init must be finite and >= 0"
+        );
+    }
+    if (!finite_pos(opt.gd.alpha_min)) {
+        return options_invalid(
+            OptionsValidationError::gd_alpha_min_nonpositive,
+            "gd.alpha_min must be finite and > 0"
+        );
+    }
+    if (!(isfinite(opt.gd.alpha_max) && opt.gd.alpha_max >= opt.gd.alpha_min)) {
+        return options_invalid(
+            OptionsValidationError::gd_alpha_bounds_invalid,
+            "gd.alpha_max must be finite and >= gd.alpha_min"
+        );
+    }
+    if (opt.gd.nonmonotone_window < 0) {
+        return options_invalid(
+            OptionsValidationError::gd_nonmonotone_window_negative,
+            "gd.nonmonotone_window must be >= 0"
+        );
+    }
+
+    if (!(finite_nonneg(opt.agd.momentum) && opt.agd.momentum < 1.0)) {
+        return options_invalid(
+            OptionsValidationError::agd_momentum_out_of_range,
+            "agd.momentum must satisfy 0 <= momentum < 1"
+        );
+    }
+    if (opt.agd.step_growth != 0.0
+        && !(isfinite(opt.agd.step_growth) && opt.agd.step_growth >= 1.0)) {
+        return options_invalid(
+            OptionsValidationError::agd_step_growth_out_of_range,
+            "agd.step_growth must be 0 or finite and >= 1"
+        );
+    }
+    if (opt.agd.ls_c1 != 0.0
+        && !(isfinite(opt.agd.ls_c1) && in_op(opt.agd.ls_c1, 0.0, opt.ls.c2))) {
+        return options_invalid(
+            OptionsValidationError::agd_ls_c1_out_of_range,
+            "agd.ls_c1 must be 0 or satisfy 0 < ls_c1 < ls.c2"
+        );
+    }
+    if (opt.agd.method == AccelMethod::heavy_ball
+        && opt.agd.restart == AccelRestart::function) {
+        return options_invalid(
+            OptionsValidationError::agd_heavy_ball_function_restart,
+            "agd.restart = function is nesterov-only (heavy_ball steps always decrease f)"
+        );
+    }
+
+    if (opt.anderson.memory < 0) {
+        return options_invalid(
+            OptionsValidationError::anderson_memory_negative,
+            "anderson.memory must be >= 0"
+        );
+    }
+    if (!finite_pos(opt.anderson.mixing)) {
+        return options_invalid(
+            OptionsValidationError::anderson_mixing_nonpositive,
+            "anderson.mixing must be finite and > 0"
+        );
+    }
+    if (!finite_nonneg(opt.anderson.regularization)) {
+        return options_invalid(
+            OptionsValidationError::anderson_regularization_negative,
+            "anderson.regularization must be finite and >= 0"
+        );
+    }
+    if (!(opt.anderson.cond_max >= 1.0)) {
+        return options_invalid(
+            OptionsValidationError::anderson_cond_max_out_of_range,
+            "anderson.cond_max must be >= 1"
+        );
+    }
+
+    if (!finite_nonneg(opt.ncg.restart_tol)) {
+        return options_invalid(
+            OptionsValidationError::ncg_restart_tol_negative,
+            "ncg.restart_tol must be finite and >= 0"
+        );
+    }
+    if (opt.ncg.restart_iters < 0) {
+        return options_invalid(
+            OptionsValidationError::ncg_restart_iters_negative,
+            "ncg.restart_iters must be >= 0"
+        );
+    }
+    if (!finite_pos(opt.ncg.hz_eta)) {
+        return options_invalid(
+            OptionsValidationError::ncg_hz_eta_nonpositive,
+            "ncg.hz_eta must be finite and > 0"
+        );
+    }
+    if (opt.ncg.ls_c2 != 0.0
+        && !(isfinite(opt.ncg.ls_c2) && in_op(opt.ncg.ls_c2, opt.ls.c1, 1.0))) {
+        return options_invalid(
+            OptionsValidationError::ncg_ls_c2_out_of_range,
+            "ncg.ls_c2 must be 0 or satisfy ls.c1 < ls_c2 < 1"
+        );
+    }
 
     if (opt.lbfgs.memory < 0) {
         return options_invalid(
@@ -180,6 +496,50 @@ inline OptionsValidationResult validate_options(const Options& opt) {
             "lbfgs.h0_scale_min must be <= lbfgs.h0_scale_max"
         );
     }
+    if (!(isfinite(opt.lowfi.max_mismatch_rate)
+          && in_cl(opt.lowfi.max_mismatch_rate, 0.0, 1.0))) {
+        return options_invalid(
+            OptionsValidationError::lowfi_max_mismatch_rate_out_of_range,
+            "lowfi.max_mismatch_rate must satisfy 0 <= rate <= 1"
+        );
+    }
+    if (opt.lowfi.min_screens < 0) {
+        return options_invalid(
+            OptionsValidationError::lowfi_min_screens_negative,
+            "lowfi.min_screens must be >= 0"
+        );
+    }
+    if (opt.parallel.threads < 0) {
+        return options_invalid(
+            OptionsValidationError::parallel_threads_negative,
+            "parallel.threads must be >= 0"
+        );
+    }
+    if (opt.parallel.min_n < 0) {
+        return options_invalid(
+            OptionsValidationError::parallel_min_n_negative,
+            "parallel.min_n must be >= 0"
+        );
+    }
+    if (opt.parallel.chunk <= 0) {
+        return options_invalid(
+            OptionsValidationError::parallel_chunk_nonpositive,
+            "parallel.chunk must be > 0"
+        );
+    }
+    if (opt.qn.harvest_pairs < 0) {
+        return options_invalid(
+            OptionsValidationError::qn_harvest_pairs_negative,
+            "qn.harvest_pairs must be >= 0"
+        );
+    }
+    if (!(isfinite(opt.qn.harvest_indep_tol) && opt.qn.harvest_indep_tol >= 0.0
+          && opt.qn.harvest_indep_tol < 1.0)) {
+        return options_invalid(
+            OptionsValidationError::qn_harvest_indep_tol_out_of_range,
+            "qn.harvest_indep_tol must satisfy 0 <= tol < 1"
+        );
+    }
     if (opt.cache.f_slots < 0) {
         return options_invalid(
             OptionsValidationError::cache_f_slots_negative,
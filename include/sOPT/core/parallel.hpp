@@ -0,0 +1,226 @@
+#pragma once
+
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/typedefs.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace sOPT::detail {
+
+// Persistent worker pool. run(fn) calls fn(w) for w = 0..size()-1 (w = 0 on the
+// calling thread) and returns when every worker is done. Calls are serialized.
+class ThreadPool {
+  public:
+    explicit ThreadPool(i32 threads) : n_(std::max(threads, 1)) {
+        for (i32 w = 1; w < n_; w++) {
+            workers_.emplace_back([this, w] { loop_(w); });
+        }
+    }
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stop_ = true;
+            ++gen_;
+        }
+        cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    i32 size() const { return n_; }
+
+    void run(const std::function<void(i32)>& fn) {
+        std::lock_guard<std::mutex> run_lk(run_mtx_);
+        if (n_ == 1) {
+            fn(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            job_ = &fn;
+            pending_ = n_ - 1;
+            ++gen_;
+        }
+        cv_.notify_all();
+        fn(0);
+        std::unique_lock<std::mutex> lk(mtx_);
+        done_cv_.wait(lk, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+  private:
+    i32 n_ = 1;
+    svec<std::thread> workers_;
+    std::mutex run_mtx_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(i32)>* job_ = nullptr;
+    i32 pending_ = 0;
+    u64 gen_ = 0;
+    bool stop_ = false;
+
+    void loop_(i32 w) {
+        u64 seen = 0;
+        std::unique_lock<std::mutex> lk(mtx_);
+        for (;;) {
+            cv_.wait(lk, [&] { return stop_ || gen_ != seen; });
+            if (stop_) return;
+            seen = gen_;
+            const auto* job = job_;
+            lk.unlock();
+            (*job)(w);
+            lk.lock();
+            if (--pending_ == 0) done_cv_.notify_one();
+        }
+    }
+};
+
+inline i32 par_threads(const ParallelOptions& po) {
+    if (po.threads > 0) return po.threads;
+    return std::max(1, static_cast<i32>(std::thread::hardware_concurrency()));
+}
+
+// Shared pools, one per thread count. A pool is never destroyed before exit, so
+// a concurrent solve with a different opt.parallel.threads cannot free a pool
+// another thread is still running on.
+inline ThreadPool& thread_pool(i32 threads) {
+    static std::map<i32, std::unique_ptr<ThreadPool>> pools;
+    static std::mutex mtx;
+    std::lock_guard<std::mutex> lk(mtx);
+    std::unique_ptr<ThreadPool>& pool = pools[threads];
+    if (!pool) pool = std::make_unique<ThreadPool>(threads);
+    return *pool;
+}
+
+// Parallel path only for threads != 1 and n >= min_n; otherwise plain Eigen.
+inline bool par_enabled(const ParallelOptions& po, i64 n) {
+    return po.threads != 1 && n >= po.min_n;
+}
+
+// Calls fn(begin, len, c) for the fixed chunks c of [0, n) (chunk = po.chunk).
+// Worker w always owns the contiguous chunk range [C w / W, C (w + 1) / W), so
+// pages first touched by par_first_touch are later processed by the same worker.
+template <typename Fn>
+void par_for_chunks(i64 n, const ParallelOptions& po, Fn&& fn) {
+    const i64 chunk = po.chunk;
+    const i64 C = (n + chunk - 1) / chunk;
+    ThreadPool& tp = thread_pool(par_threads(po));
+    const i64 W = tp.size();
+    tp.run([&](i32 w) {
+        const i64 c0 = C * w / W;
+        const i64 c1 = C * (w + 1) / W;
+        for (i64 c = c0; c < c1; c++) {
+            const i64 begin = c * chunk;
+            fn(begin, std::min(chunk, n - begin), c);
+        }
+    });
+}
+
+// Chunk partials summed in chunk order: identical for any thread count.
+template <typename PartialFn>
+f64 par_reduce(i64 n, const ParallelOptions& po, PartialFn&& partial) {
+    const i64 C = (n + po.chunk - 1) / po.chunk;
+    svec<f64> part(static_cast<std::size_t>(C), 0.0);
+    par_for_chunks(n, po, [&](i64 b, i64 len, i64 c) { part[c] = partial(b, len); });
+    f64 acc = 0.0;
+    for (const f64 v : part) acc += v;
+    return acc;
+}
+
+inline f64 par_dot(ecref<vecXd> a, ecref<vecXd> b, const ParallelOptions& po) {
+    const i64 n = a.size();
+    if (!par_enabled(po, n)) return a.dot(b);
+    return par_reduce(n, po, [&](i64 i0, i64 len) {
+        return a.segment(i0, len).dot(b.segment(i0, len));
+    });
+}
+
+inline f64 par_squared_norm(ecref<vecXd> a, const ParallelOptions& po) {
+    const i64 n = a.size();
+    if (!par_enabled(po, n)) return a.squaredNorm();
+    return par_reduce(n, po, [&](i64 i0, i64 len) {
+        return a.segment(i0, len).squaredNorm();
+    });
+}
+
+inline f64 par_norm(ecref<vecXd> a, const ParallelOptions& po) {
+    return std::sqrt(par_squared_norm(a, po));
+}
+
+// ||a - b||
+inline f64 par_distance(ecref<vecXd> a, ecref<vecXd> b, const ParallelOptions& po) {
+    const i64 n = a.size();
+    if (!par_enabled(po, n)) return (a - b).norm();
+    return std::sqrt(par_reduce(n, po, [&](i64 i0, i64 len) {
+        return (a.segment(i0, len) - b.segment(i0, len)).squaredNorm();
+    }));
+}
+
+// out = a x
+inline void par_scale(f64 a, ecref<vecXd> x, eref<vecXd> out, const ParallelOptions& po) {
+    const i64 n = x.size();
+    if (!par_enabled(po, n)) {
+        out.noalias() = a * x;
+        return;
+    }
+    par_for_chunks(n, po, [&](i64 i0, i64 len, i64) {
+        out.segment(i0, len).noalias() = a * x.segment(i0, len);
+    });
+}
+
+// y += a x
+inline void par_axpy(f64 a, ecref<vecXd> x, eref<vecXd> y, const ParallelOptions& po) {
+    const i64 n = x.size();
+    if (!par_enabled(po, n)) {
+        y.noalias() += a * x;
+        return;
+    }
+    par_for_chunks(n, po, [&](i64 i0, i64 len, i64) {
+        y.segment(i0, len).noalias() += a * x.segment(i0, len);
+    });
+}
+
+// out = a x + b z
+inline void par_lincomb(
+    f64 a,
+    ecref<vecXd> x,
+    f64 b,
+    ecref<vecXd> z,
+    eref<vecXd> out,
+    const ParallelOptions& po
+) {
+    const i64 n = x.size();
+    if (!par_enabled(po, n)) {
+        out.noalias() = a * x + b * z;
+        return;
+    }
+    par_for_chunks(n, po, [&](i64 i0, i64 len, i64) {
+        out.segment(i0, len).noalias() = a * x.segment(i0, len) + b * z.segment(i0, len);
+    });
+}
+
+// Zero-fill rows x cols column-major storage with the same row chunking the
+// kernels use, so each page is first touched (and NUMA-placed) by its worker.
+template <typename T>
+void par_first_touch(T* data, i64 rows, i64 cols, const ParallelOptions& po) {
+    if (!par_enabled(po, rows)) return;
+    par_for_chunks(rows, po, [&](i64 i0, i64 len, i64) {
+        for (i64 j = 0; j < cols; j++) std::fill_n(data + j * rows + i0, len, T(0));
+    });
+}
+
+inline void par_first_touch(vecXd& v, const ParallelOptions& po) {
+    par_first_touch(v.data(), v.size(), 1, po);
+}
+
+} // namespace sOPT::detail
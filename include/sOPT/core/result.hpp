@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sOPT/core/callback.hpp"
+#include "sOPT/core/line_search_stats.hpp"
 #include "sOPT/core/options.hpp"
 #include "sOPT/core/status.hpp"
 #include "sOPT/core/trace.hpp"
@@ -20,6 +21,18 @@ struct Result {
     i32 f_evals = 0;
     i32 g_evals = 0;
     i32 h_evals = 0;
+    i32 hv_evals = 0;
+    i32 jv_evals = 0; // Jacobian products J v, J^T u (least squares)
+    i32 lowfi_evals = 0;
+    i32 lowfi_mismatches = 0;
+    i32 harvested_pairs = 0; // secant pairs from line-search trials (opt.qn)
+    i32 cg_iters = 0;        // inner CG / GMRES iterations (Newton-CG/Krylov, SteihaugCG)
+    i32 neg_curvature = 0;   // inner solves stopped by d^T H d <= 0
+    i32 tr_rejected = 0;     // trust-region / LM trial steps with rho <= eta_accept
+
+    // Line-search statistics (totals and per-step histograms)
+    LineSearchSummary ls;
+    i32 f_bounded_rejects = 0; // capped probes stopped early by func_bounded
 
     // Trace
     std::optional<Trace> trace;
@@ -28,7 +41,7 @@ struct Result {
             trace.emplace();
             const i32 cap
                 = (opt.trace_reserve > 0) ? opt.trace_reserve : opt.term.max_iters + 1;
-            trace->reserve(cap, opt.trace_level, opt.diag.enabled);
+            trace->reserve(cap, opt.trace_level, opt.diag.enabled, opt.trace_line_search);
         }
     }
 
@@ -58,6 +71,15 @@ struct Result {
             if (opt.diag.enabled) {
                 // Push optional diagnostics
             }
+            if (opt.trace_line_search) {
+                const LineSearchStats& ls_last = oracle.ls_stats();
+                trace->ls_phi_evals.push_back(ls_last.phi_evals);
+                trace->ls_dphi_evals.push_back(ls_last.dphi_evals);
+                trace->ls_backtracks.push_back(ls_last.backtracks);
+                trace->ls_expansions.push_back(ls_last.expansions);
+                trace->ls_zoom_iters.push_back(ls_last.zoom_iters);
+                trace->ls_full_step_rejects.push_back(ls_last.full_step_rejects);
+            }
             break;
         case TraceLevel::off: [[unlikely]]; break; // unreachable
         }
@@ -68,6 +90,12 @@ struct Result {
         f_evals = oracle.f_evals();
         g_evals = oracle.g_evals();
         h_evals = oracle.h_evals();
+        hv_evals = oracle.hv_evals();
+        jv_evals = oracle.jv_evals();
+        lowfi_evals = oracle.lowfi_evals();
+        lowfi_mismatches = oracle.lowfi_mismatches();
+        ls = oracle.ls_summary();
+        f_bounded_rejects = oracle.f_bounded_rejects();
     }
 };
 
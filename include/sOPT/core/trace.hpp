@@ -29,10 +29,22 @@ struct Trace {
     svec<f64> hdiag_min;
     svec<f64> hdiag_max;
     svec<f64> cond_est;
-    // Reserve vectors
 
-    void
-    reserve(i32 n, TraceLevel trace_level = TraceLevel::off, bool with_diag = false) {
+    // Optional line-search counters (opt.trace_line_search)
+    svec<i32> ls_phi_evals;
+    svec<i32> ls_dphi_evals;
+    svec<i32> ls_backtracks;
+    svec<i32> ls_expansions;
+    svec<i32> ls_zoom_iters;
+    svec<i32> ls_full_step_rejects;
+
+    // Reserve vectors
+    void reserve(
+        i32 n,
+        TraceLevel trace_level = TraceLevel::off,
+        bool with_diag = false,
+        bool with_ls = false
+    ) {
         switch (trace_level) {
         case TraceLevel::off: return;
         case TraceLevel::full:
@@ -54,6 +66,14 @@ struct Trace {
                 hdiag_max.reserve(n);
                 cond_est.reserve(n);
             }
+            if (with_ls) {
+                ls_phi_evals.reserve(n);
+                ls_dphi_evals.reserve(n);
+                ls_backtracks.reserve(n);
+                ls_expansions.reserve(n);
+                ls_zoom_iters.reserve(n);
+                ls_full_step_rejects.reserve(n);
+            }
             return;
         }
     }
@@ -4,6 +4,7 @@
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
 
 namespace sOPT {
 
@@ -23,6 +24,8 @@ template <int N, int M> using matf = eig::Matrix<f32, N, M>;
 template <typename T> using matX = eig::MatrixX<T>;
 using matXd = eig::MatrixXd;
 using matXf = eig::MatrixXf;
+using spmatXd = eig::SparseMatrix<f64>; // column-major, i32 indices
+using tripletd = eig::Triplet<f64>;
 
 template <typename T, int N> using vec = eig::Vector<T, N>;
 template <int N> using vecd = eig::Vector<f64, N>;
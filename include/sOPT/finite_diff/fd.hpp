@@ -2,4 +2,5 @@
 
 #include "sOPT/finite_diff/fd_grad.hpp"
 #include "sOPT/finite_diff/fd_hess.hpp"
-#include "sOPT/finite_diff/fd_hv.hpp"
\ No newline at end of file
+#include "sOPT/finite_diff/fd_hv.hpp"
+#include "sOPT/finite_diff/fd_jac.hpp"
\ No newline at end of file
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "sOPT/core/vecdefs.hpp"
+
+namespace sOPT {
+// Jacobian of the residual r : R^n -> R^m and its products J v, J^T u.
+// r is the residual at x (already known to the caller); probes go through
+// oracle.try_residual_probe, which is counted but does not touch the residual slot.
+
+// Jacobian, one column per coordinate ------------------------------------------
+template <typename OracleT>
+inline bool fd_jacobian_forward(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> r,
+    eref<matXd> J,
+    f64 eps = 1e-8
+) {
+    const i32 n = static_cast<i32>(x.size());
+
+    vecXd xph = x;
+    vecXd rph(r.size());
+    for (i32 i = 0; i < n; i++) {
+        const f64 h = eps * (1.0 + std::abs(x(i)));
+        xph(i) = x(i) + h;
+        if (!oracle.try_residual_probe(xph, rph)) return false;
+        J.col(i) = (rph - r) / h;
+        xph(i) = x(i); // reset
+    }
+    return J.allFinite();
+}
+
+template <typename OracleT>
+inline bool fd_jacobian_backward(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> r,
+    eref<matXd> J,
+    f64 eps = 1e-8
+) {
+    const i32 n = static_cast<i32>(x.size());
+
+    vecXd xmh = x;
+    vecXd rmh(r.size());
+    for (i32 i = 0; i < n; i++) {
+        const f64 h = eps * (1.0 + std::abs(x(i)));
+        xmh(i) = x(i) - h;
+        if (!oracle.try_residual_probe(xmh, rmh)) return false;
+        J.col(i) = (r - rmh) / h;
+        xmh(i) = x(i); // reset
+    }
+    return J.allFinite();
+}
+
+template <typename OracleT>
+inline bool fd_jacobian_central(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> r,
+    eref<matXd> J,
+    f64 eps = 1e-6
+) {
+    const i32 n = static_cast<i32>(x.size());
+
+    vecXd xph = x;
+    vecXd xmh = x;
+    vecXd rph(r.size());
+    vecXd rmh(r.size());
+    for (i32 i = 0; i < n; i++) {
+        const f64 h = eps * (1.0 + std::abs(x(i)));
+        xph(i) = x(i) + h;
+        xmh(i) = x(i) - h;
+        if (!oracle.try_residual_probe(xph, rph)) return false;
+        if (!oracle.try_residual_probe(xmh, rmh)) return false;
+        J.col(i) = (rph - rmh) / (2.0 * h);
+        xph(i) = x(i);
+        xmh(i) = x(i);
+    }
+    return J.allFinite();
+}
+
+// Jacobian-vector product J v -------------------------------------------------
+// one directional difference, h scaled by v as in fd_hv
+template <typename OracleT>
+inline bool fd_jvp_forward(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> r,
+    ecref<vecXd> v,
+    eref<vecXd> Jv,
+    f64 eps = 1e-8
+) {
+    const f64 vnorm = v.norm();
+    if (vnorm == 0.0) {
+        Jv.setZero();
+        return true;
+    }
+    const f64 h = eps * (1.0 + x.norm()) / vnorm;
+    vecXd xph = x;
+    xph.noalias() += h * v;
+    if (!oracle.try_residual_probe(xph, Jv)) return false;
+    Jv = (Jv - r) / h;
+    return Jv.allFinite();
+}
+
+template <typename OracleT>
+inline bool fd_jvp_backward(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> r,
+    ecref<vecXd> v,
+    eref<vecXd> Jv,
+    f64 eps = 1e-8
+) {
+    const f64 vnorm = v.norm();
+    if (vnorm == 0.0) {
+        Jv.setZero();
+        return true;
+    }
+    const f64 h = eps * (1.0 + x.norm()) / vnorm;
+    vecXd xmh = x;
+    xmh.noalias() -= h * v;
+    if (!oracle.try_residual_probe(xmh, Jv)) return false;
+    Jv = (r - Jv) / h;
+    return Jv.allFinite();
+}
+
+template <typename OracleT>
+inline bool fd_jvp_central(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> v,
+    eref<vecXd> Jv,
+    f64 eps = 1e-6
+) {
+    const f64 vnorm = v.norm();
+    if (vnorm == 0.0) {
+        Jv.setZero();
+        return true;
+    }
+    const f64 h = eps * (1.0 + x.norm()) / vnorm;
+    vecXd xph = x;
+    vecXd xmh = x;
+    xph.noalias() += h * v;
+    xmh.noalias() -= h * v;
+    vecXd rmh(Jv.size());
+    if (!oracle.try_residual_probe(xph, Jv)) return false;
+    if (!oracle.try_residual_probe(xmh, rmh)) return false;
+    Jv = (Jv - rmh) / (2.0 * h);
+    return Jv.allFinite();
+}
+
+// vector-Jacobian product J^T u -----------------------------------------------
+// (J^T u)_i = d(u^T r)/dx_i, one coordinate at a time: same residual count as the
+// FD Jacobian, but O(m + n) memory
+template <typename OracleT>
+inline bool fd_vjp_forward(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> r,
+    ecref<vecXd> u,
+    eref<vecXd> JTu,
+    f64 eps = 1e-8
+) {
+    const i32 n = static_cast<i32>(x.size());
+
+    const f64 ur = u.dot(r);
+    vecXd xph = x;
+    vecXd rph(r.size());
+    for (i32 i = 0; i < n; i++) {
+        const f64 h = eps * (1.0 + std::abs(x(i)));
+        xph(i) = x(i) + h;
+        if (!oracle.try_residual_probe(xph, rph)) return false;
+        JTu(i) = (u.dot(rph) - ur) / h;
+        xph(i) = x(i); // reset
+    }
+    return JTu.allFinite();
+}
+
+template <typename OracleT>
+inline bool fd_vjp_backward(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> r,
+    ecref<vecXd> u,
+    eref<vecXd> JTu,
+    f64 eps = 1e-8
+) {
+    const i32 n = static_cast<i32>(x.size());
+
+    const f64 ur = u.dot(r);
+    vecXd xmh = x;
+    vecXd rmh(r.size());
+    for (i32 i = 0; i < n; i++) {
+        const f64 h = eps * (1.0 + std::abs(x(i)));
+        xmh(i) = x(i) - h;
+        if (!oracle.try_residual_probe(xmh, rmh)) return false;
+        JTu(i) = (ur - u.dot(rmh)) / h;
+        xmh(i) = x(i); // reset
+    }
+    return JTu.allFinite();
+}
+
+template <typename OracleT>
+inline bool fd_vjp_central(
+    OracleT& oracle,
+    ecref<vecXd> x,
+    ecref<vecXd> u,
+    eref<vecXd> JTu,
+    f64 eps = 1e-6
+) {
+    const i32 n = static_cast<i32>(x.size());
+
+    vecXd xph = x;
+    vecXd xmh = x;
+    vecXd rph(u.size());
+    vecXd rmh(u.size());
+    for (i32 i = 0; i < n; i++) {
+        const f64 h = eps * (1.0 + std::abs(x(i)));
+        xph(i) = x(i) + h;
+        xmh(i) = x(i) - h;
+        if (!oracle.try_residual_probe(xph, rph)) return false;
+        if (!oracle.try_residual_probe(xmh, rmh)) return false;
+        JTu(i) = u.dot(rph - rmh) / (2.0 * h);
+        xph(i) = x(i);
+        xmh(i) = x(i);
+    }
+    return JTu.allFinite();
+}
+
+} // namespace sOPT
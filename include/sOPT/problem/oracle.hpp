@@ -1,11 +1,14 @@
 #pragma once
 
+#include "sOPT/core/line_search_stats.hpp"
 #include "sOPT/core/options.hpp"
 #include "sOPT/core/typedefs.hpp"
 #include "sOPT/core/util.hpp"
 #include "sOPT/core/vecdefs.hpp"
 #include "sOPT/finite_diff/fd_grad.hpp"
+#include "sOPT/finite_diff/fd_jac.hpp"
 #include "sOPT/problem/traits.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace sOPT {
@@ -21,15 +24,92 @@ class Oracle {
     // try evals
     bool try_func(ecref<vecXd> x, f64& fx) {
         if (cache_lookup_(f_cache_, x, fx)) return true;
-        if (!can_eval_f_()) return false;
-        ++f_evals_;
-        fx = obj_.func(x);
+        if constexpr (!has_func_v<Obj> && is_least_squares_v<Obj>) {
+            if (!eval_residual_(x)) return false;
+            fx = 0.5 * rs_.squaredNorm(); // f = 1/2 ||r||^2
+        } else {
+            if (!can_eval_f_()) return false;
+            ++f_evals_;
+            fx = obj_.func(x);
+        }
         if (!isfinite(fx)) return false;
         cache_store_(f_cache_, x, fx);
         return true;
     }
+    // f(x) where only f <= f_cap matters (line-search acceptance). Results above
+    // f_cap may come from an early abort: they count as rejected and are not cached
+    // as f values. With opt.cache.enabled the last one is kept as a lower bound, so
+    // a repeated probe at the same x that it already rejects is not re-evaluated.
+    bool try_func_bounded(ecref<vecXd> x, f64 f_cap, f64& fx) {
+        if constexpr (has_func_bounded_v<Obj>) {
+            if (cache_lookup_(f_cache_, x, fx)) return true;
+            if (f_reject_ready_ && opt_.cache.enabled && f_reject_lb_ > f_cap
+                && same_x_(f_reject_x_, x)) {
+                fx = f_reject_lb_; // known lower bound already rejects
+                return true;
+            }
+            if (!can_eval_f_()) return false;
+            ++f_evals_;
+            fx = obj_.func_bounded(x, f_cap);
+            if (fx > f_cap) {
+                ++f_bounded_rejects_;
+                if (opt_.cache.enabled) {
+                    f_reject_x_ = x;
+                    f_reject_lb_ = fx;
+                    f_reject_ready_ = true;
+                }
+                return true;
+            }
+            if (!isfinite(fx)) return false;
+            cache_store_(f_cache_, x, fx);
+            return true;
+        } else {
+            (void)f_cap;
+            return try_func(x, fx);
+        }
+    }
+    // z = M(x)^{-1} r from the objective's preconditioner (has_precondition_v),
+    // otherwise z = r. Not counted.
+    bool try_precondition(ecref<vecXd> x, ecref<vecXd> r, eref<vecXd> z) {
+        if constexpr (has_precondition_v<Obj>) {
+            obj_.precondition(x, r, z);
+            return z.allFinite();
+        } else {
+            (void)x;
+            z = r;
+            return true;
+        }
+    }
+
+    // cheap low-fidelity model, used only to screen line-search trials
+    // (not cached, not limited, counted separately)
+    bool try_func_lowfi(ecref<vecXd> x, f64& fx) {
+        if constexpr (has_func_lowfi_v<Obj>) {
+            ++lowfi_evals_;
+            fx = obj_.func_lowfi(x);
+            return isfinite(fx);
+        } else {
+            (void)x;
+            (void)fx;
+            return false;
+        }
+    }
     bool try_gradient(ecref<vecXd> x, eref<vecXd> g) {
         if (cache_lookup_(g_cache_, x, g)) return true;
+        if constexpr (!has_gradient_v<Obj> && is_least_squares_v<Obj>) {
+            if (!eval_residual_(x)) return false; // g = J^T r
+            if constexpr (!has_jacobian_v<Obj> && has_vjp_v<Obj>) {
+                if (!can_eval_g_()) return false;
+                ++g_evals_;
+                obj_.vjp(x, rs_, g);
+            } else {
+                if (!eval_jacobian_(x)) return false;
+                g.noalias() = js_.transpose() * rs_;
+            }
+            if (!g.allFinite()) return false;
+            cache_store_(g_cache_, x, g);
+            return true;
+        }
         if (!can_eval_g_()) return false;
         ++g_evals_;
         if constexpr (has_gradient_v<Obj>) {
@@ -63,6 +143,13 @@ class Oracle {
     bool try_hessian(ecref<vecXd> x, eref<matXd> H) {
         maybe_apply_hessian_guard_(static_cast<i32>(x.size()));
         if (cache_lookup_(h_cache_, x, H)) return true;
+        if constexpr (!has_hessian_v<Obj> && has_hessian_sparse_v<Obj>) {
+            if (!eval_hessian_sparse_(x)) return false; // dense copy of the sparse one
+            H = matXd(hs_);
+            H.triangularView<eSUp>() = H.transpose();
+            cache_store_(h_cache_, x, H);
+            return true;
+        }
         if (!can_eval_h_()) return false;
         ++h_evals_;
         if constexpr (has_hessian_v<Obj>) {
@@ -93,6 +180,15 @@ class Oracle {
         cache_store_(h_cache_, x, H);
         return true;
     }
+    // sparse Hessian (has_hessian_sparse_v only, no FD fallback): lower triangle,
+    // fixed pattern. The last evaluation is kept in one slot keyed on x and shared
+    // with try_hv. H points at that slot (no copy) and is valid until the next
+    // sparse Hessian evaluation.
+    bool try_hessian_sparse(ecref<vecXd> x, const spmatXd*& H) {
+        if (!eval_hessian_sparse_(x)) return false;
+        H = &hs_;
+        return true;
+    }
     bool try_hv(ecref<vecXd> x, ecref<vecXd> v, eref<vecXd> Hv) {
         const i32 n = static_cast<i32>(x.size());
         if (v.size() != n || Hv.size() != n) return false;
@@ -106,6 +202,10 @@ class Oracle {
             if (!try_hessian(x, hv_H_)) return false;
             Hv.noalias() = hv_H_.selfadjointView<eig::Lower>() * v;
             return Hv.allFinite();
+        } else if constexpr (has_hessian_sparse_v<Obj>) {
+            if (!eval_hessian_sparse_(x)) return false;
+            Hv.noalias() = hs_.selfadjointView<eig::Lower>() * v;
+            return Hv.allFinite();
         } else {
             switch (opt_.fd.fallback_hv) {
             case FallbackHv::fd_forward:
@@ -125,11 +225,204 @@ class Oracle {
         return false;
     }
 
+    // least-squares evals (is_least_squares_v)
+    // r(x) counts as an f eval and J(x) = dr/dx as a g eval (FD fallback through
+    // opt.fd.fallback_jac). The last residual and Jacobian are kept in one slot each,
+    // keyed on x, and shared with the f = 1/2 ||r||^2 and g = J^T r paths above.
+    i32 num_residuals() const {
+        if constexpr (is_least_squares_v<Obj>) {
+            return static_cast<i32>(obj_.num_residuals());
+        } else {
+            return 0;
+        }
+    }
+    bool try_residual(ecref<vecXd> x, eref<vecXd> r) {
+        if (r.size() != num_residuals() || !eval_residual_(x)) return false;
+        r = rs_;
+        return true;
+    }
+    bool try_jacobian(ecref<vecXd> x, eref<matXd> J) {
+        if (J.rows() != num_residuals() || J.cols() != x.size()) return false;
+        if (!eval_jacobian_(x)) return false;
+        J = js_;
+        return true;
+    }
+    // Jacobian products (counted as jv evals, not limited): analytic jvp/vjp, else the
+    // Jacobian slot if jacobian() exists or the slot already holds J(x) (e.g. an FD
+    // Jacobian built for g = J^T r), else FD around the residual slot
+    // (opt.fd.fallback_jac; J v costs 1-2 residuals, J^T u costs n-2n)
+    bool try_jvp(ecref<vecXd> x, ecref<vecXd> v, eref<vecXd> Jv) {
+        if (v.size() != x.size() || Jv.size() != num_residuals()) return false;
+        ++jv_evals_;
+        if constexpr (has_jvp_v<Obj>) {
+            obj_.jvp(x, v, Jv);
+            return Jv.allFinite();
+        } else if constexpr (has_jacobian_v<Obj>) {
+            if (!eval_jacobian_(x)) return false;
+            Jv.noalias() = js_ * v;
+            return Jv.allFinite();
+        } else {
+            if (jacobian_at_(x)) {
+                Jv.noalias() = js_ * v;
+                return Jv.allFinite();
+            }
+            if (!eval_residual_(x)) return false;
+            const f64 eps = opt_.fd.eps;
+            switch (opt_.fd.fallback_jac) {
+            case FallbackJac::fd_forward:
+                return fd_jvp_forward(*this, x, rs_, v, Jv, eps);
+            case FallbackJac::fd_backward:
+                return fd_jvp_backward(*this, x, rs_, v, Jv, eps);
+            case FallbackJac::fd_central:
+                return fd_jvp_central(*this, x, v, Jv, eps);
+            }
+        }
+        return false;
+    }
+    bool try_vjp(ecref<vecXd> x, ecref<vecXd> u, eref<vecXd> JTu) {
+        if (u.size() != num_residuals() || JTu.size() != x.size()) return false;
+        ++jv_evals_;
+        if constexpr (has_vjp_v<Obj>) {
+            obj_.vjp(x, u, JTu);
+            return JTu.allFinite();
+        } else if constexpr (has_jacobian_v<Obj>) {
+            if (!eval_jacobian_(x)) return false;
+            JTu.noalias() = js_.transpose() * u;
+            return JTu.allFinite();
+        } else {
+            if (jacobian_at_(x)) {
+                JTu.noalias() = js_.transpose() * u;
+                return JTu.allFinite();
+            }
+            if (!eval_residual_(x)) return false;
+            const f64 eps = opt_.fd.eps;
+            switch (opt_.fd.fallback_jac) {
+            case FallbackJac::fd_forward:
+                return fd_vjp_forward(*this, x, rs_, u, JTu, eps);
+            case FallbackJac::fd_backward:
+                return fd_vjp_backward(*this, x, rs_, u, JTu, eps);
+            case FallbackJac::fd_central:
+                return fd_vjp_central(*this, x, u, JTu, eps);
+            }
+        }
+        return false;
+    }
+    // r(x) for FD Jacobian probes: counted, bypasses the residual slot
+    bool try_residual_probe(ecref<vecXd> x, eref<vecXd> r) {
+        if constexpr (is_least_squares_v<Obj>) {
+            if (!can_eval_f_()) return false;
+            ++f_evals_;
+            obj_.residual(x, r);
+            return r.allFinite();
+        } else {
+            (void)x;
+            (void)r;
+            return false;
+        }
+    }
+
+    // line-search ray evals
+    // begin_ray prepares the objective for probes along x + alpha * p; it is a
+    // no-op if the objective has no ray trait or the same ray is already prepared.
+    void begin_ray(ecref<vecXd> x, ecref<vecXd> p) {
+        if constexpr (has_ray_func_v<Obj>) {
+            if (ray_ready_ && same_x_(ray_x_, x) && same_x_(ray_p_, p)) return;
+            obj_.prepare_ray(x, p);
+            ray_x_ = x;
+            ray_p_ = p;
+            ray_ready_ = true;
+        } else {
+            (void)x;
+            (void)p;
+        }
+    }
+    // phi(alpha) = f(xt), xt = x + alpha * p of the prepared ray. Counted and
+    // cached as a regular f eval keyed on xt. A finite f_cap (acceptance bound)
+    // allows a bounded evaluation when the ray path is unavailable.
+    bool try_func_along(f64 alpha, ecref<vecXd> xt, f64& ft, f64 f_cap = inf<f64>) {
+        ++ls_step_.phi_evals;
+        if constexpr (has_ray_func_v<Obj>) {
+            if (ray_ready_) {
+                if (cache_lookup_(f_cache_, xt, ft)) return true;
+                if (!can_eval_f_()) return false;
+                ++f_evals_;
+                ft = obj_.func_along(alpha);
+                if (!isfinite(ft)) return false;
+                cache_store_(f_cache_, xt, ft);
+                return true;
+            }
+        }
+        (void)alpha;
+        if (isfinite(f_cap)) return try_func_bounded(xt, f_cap, ft);
+        return try_func(xt, ft);
+    }
+    // phi'(alpha) = g(xt)^T p. The ray path returns the scalar only: it is counted
+    // as a phi' probe, not a g eval, and so is not limited by max_g_evals. The
+    // solver still evaluates the full gradient once at the accepted point (the
+    // fallback path caches it instead).
+    bool try_dfunc_along(f64 alpha, ecref<vecXd> xt, ecref<vecXd> p, f64& dft) {
+        ++ls_step_.dphi_evals;
+        if constexpr (has_ray_dfunc_v<Obj>) {
+            if (ray_ready_) {
+                dft = obj_.dfunc_along(alpha);
+                return isfinite(dft);
+            }
+        }
+        (void)alpha;
+        if (ray_g_.size() != xt.size()) ray_g_.resize(xt.size());
+        if (!try_gradient(xt, ray_g_)) return false;
+        record_trial_(alpha, ray_g_);
+        dft = ray_g_.dot(p);
+        return isfinite(dft);
+    }
+    // p^T H(x) p through try_hv; the product lives in oracle scratch
+    bool try_curvature_along(ecref<vecXd> x, ecref<vecXd> p, f64& pHp) {
+        if (ray_hp_.size() != x.size()) ray_hp_.resize(x.size());
+        if (!try_hv(x, p, ray_hp_)) return false;
+        pHp = p.dot(ray_hp_);
+        return true;
+    }
+
     // eval helpers
     i32 f_evals() const { return f_evals_; }
     i32 g_evals() const { return g_evals_; }
     i32 h_evals() const { return h_evals_; }
     i32 hv_evals() const { return hv_evals_; }
+    i32 jv_evals() const { return jv_evals_; }
+    i32 f_bounded_rejects() const { return f_bounded_rejects_; }
+
+    // low-fidelity screening statistics
+    // mismatch: trial passed the low-fidelity screen but failed the full check
+    i32 lowfi_evals() const { return lowfi_evals_; }
+    i32 lowfi_screens() const { return lowfi_screens_; }
+    i32 lowfi_mismatches() const { return lowfi_mismatches_; }
+    void record_lowfi_screen(bool mismatch) {
+        ++lowfi_screens_;
+        if (mismatch) ++lowfi_mismatches_;
+    }
+    bool lowfi_trusted() const {
+        if (!has_func_lowfi_v<Obj>) return false;
+        if (lowfi_screens_ < opt_.lowfi.min_screens) return true;
+        return lowfi_mismatches_ <= opt_.lowfi.max_mismatch_rate * lowfi_screens_;
+    }
+
+    // line-search statistics
+    // ls_stats(): counters of the current (or last finished) step attempt
+    void ls_begin() {
+        ls_step_ = {};
+        trial_count_ = 0;
+    }
+    void ls_end() { ls_summary_.record(ls_step_); }
+    LineSearchStats& ls_stats() { return ls_step_; }
+    const LineSearchStats& ls_stats() const { return ls_step_; }
+    const LineSearchSummary& ls_summary() const { return ls_summary_; }
+
+    // line-search trial gradients of the current step (opt.qn.harvest_pairs > 0)
+    // The last harvest_pairs + 1 phi' probes that produced a full gradient, oldest
+    // first; the final one is usually the accepted point.
+    i32 ls_trial_count() const { return trial_count_; }
+    f64 ls_trial_alpha(i32 i) const { return trial_alpha_[trial_slot_(i)]; }
+    const vecXd& ls_trial_grad(i32 i) const { return trial_g_[trial_slot_(i)]; }
 
     // cache helpers
     i32 f_cache_slots() const { return f_cache_.slots(); }
@@ -298,6 +591,75 @@ class Oracle {
         return !limit_enabled(opt_.limits.max_h_evals)
                || (h_evals_ < opt_.limits.max_h_evals);
     }
+    bool eval_hessian_sparse_(ecref<vecXd> x) {
+        if constexpr (has_hessian_sparse_v<Obj>) {
+            if (hs_ready_ && opt_.cache.enabled && same_x_(hs_x_, x)) return true;
+            hs_ready_ = false;
+            if (!can_eval_h_()) return false;
+            ++h_evals_;
+            obj_.hessian_sparse(x, hs_);
+            if (hs_.rows() != x.size() || hs_.cols() != x.size()) return false;
+            hs_.makeCompressed();
+            const eig::Map<const vecXd> vals(hs_.valuePtr(), hs_.nonZeros());
+            if (!vals.allFinite()) return false;
+            hs_x_ = x;
+            hs_ready_ = true;
+            return true;
+        } else {
+            (void)x;
+            return false;
+        }
+    }
+
+    bool eval_residual_(ecref<vecXd> x) {
+        if (rs_ready_ && opt_.cache.enabled && same_x_(rs_x_, x)) return true;
+        rs_ready_ = false;
+        if (rs_.size() != num_residuals()) rs_.resize(num_residuals());
+        if (!try_residual_probe(x, rs_)) return false;
+        rs_x_ = x;
+        rs_ready_ = true;
+        return true;
+    }
+    bool jacobian_at_(ecref<vecXd> x) const {
+        return js_ready_ && opt_.cache.enabled && same_x_(js_x_, x);
+    }
+    bool eval_jacobian_(ecref<vecXd> x) {
+        if constexpr (is_least_squares_v<Obj>) {
+            if (jacobian_at_(x)) return true;
+            js_ready_ = false;
+            const i32 m = num_residuals();
+            const i32 n = static_cast<i32>(x.size());
+            if (js_.rows() != m || js_.cols() != n) js_.resize(m, n);
+            if constexpr (has_jacobian_v<Obj>) {
+                if (!can_eval_g_()) return false;
+                ++g_evals_;
+                obj_.jacobian(x, js_);
+            } else { // finite difference fallbacks around r(x)
+                if (!eval_residual_(x)) return false;
+                if (!can_eval_g_()) return false;
+                ++g_evals_;
+                const f64 eps = opt_.fd.eps;
+                switch (opt_.fd.fallback_jac) {
+                case FallbackJac::fd_forward:
+                    if (!fd_jacobian_forward(*this, x, rs_, js_, eps)) return false;
+                    break;
+                case FallbackJac::fd_backward:
+                    if (!fd_jacobian_backward(*this, x, rs_, js_, eps)) return false;
+                    break;
+                case FallbackJac::fd_central:
+                    if (!fd_jacobian_central(*this, x, rs_, js_, eps)) return false;
+                    break;
+                }
+            }
+            if (!js_.allFinite()) return false;
+            js_x_ = x;
+            js_ready_ = true;
+            return true;
+        } else {
+            (void)x;
+            return false;
+        }
+    }
 
   private:
     const Obj& obj_;
@@ -308,12 +670,71 @@ class Oracle {
     i32 g_evals_ = 0;
     i32 h_evals_ = 0;
     i32 hv_evals_ = 0;
+    i32 jv_evals_ = 0; // jvp + vjp products
+    i32 f_bounded_rejects_ = 0; // bounded evals returned above f_cap
+    i32 lowfi_evals_ = 0;
+    i32 lowfi_screens_ = 0;
+    i32 lowfi_mismatches_ = 0;
 
     // cache
     CacheSet<f64> f_cache_;
     CacheSet<vecXd> g_cache_;
     CacheSet<matXd> h_cache_;
     matXd hv_H_; // temp to avoid reallocating
+
+    // last sparse Hessian (one slot)
+    bool hs_ready_ = false;
+    spmatXd hs_;
+    vecXd hs_x_;
+
+    // last residual and Jacobian (one slot each, is_least_squares_v)
+    bool rs_ready_ = false;
+    vecXd rs_;
+    vecXd rs_x_;
+    bool js_ready_ = false;
+    matXd js_;
+    vecXd js_x_;
+
+    // last bounded rejection (lower bound only, never an exact cache value)
+    bool f_reject_ready_ = false;
+    vecXd f_reject_x_;
+    f64 f_reject_lb_ = qNaN<f64>;
+
+    // line-search ray
+    bool ray_ready_ = false;
+    vecXd ray_x_;
+    vecXd ray_p_;
+    vecXd ray_g_; // dphi fallback gradient
+    vecXd ray_hp_; // H p for try_curvature_along
+
+    // line-search statistics
+    LineSearchStats ls_step_;
+    LineSearchSummary ls_summary_;
+
+    // line-search trial gradients (ring, trial_count_ most recent)
+    svec<f64> trial_alpha_;
+    svec<vecXd> trial_g_;
+    i32 trial_count_ = 0;
+    i32 trial_total_ = 0; // records since ls_begin (ring position)
+
+    void record_trial_(f64 alpha, ecref<vecXd> g) {
+        const i32 cap = opt_.qn.harvest_pairs > 0 ? opt_.qn.harvest_pairs + 1 : 0;
+        if (cap == 0) return;
+        if (static_cast<i32>(trial_g_.size()) != cap) {
+            trial_alpha_.assign(cap, 0.0);
+            trial_g_.assign(cap, vecXd());
+        }
+        if (trial_count_ == 0) trial_total_ = 0;
+        const i32 slot = trial_total_ % cap;
+        trial_alpha_[slot] = alpha;
+        trial_g_[slot] = g;
+        ++trial_total_;
+        trial_count_ = std::min(trial_count_ + 1, cap);
+    }
+    i32 trial_slot_(i32 i) const {
+        const i32 cap = static_cast<i32>(trial_g_.size());
+        return (trial_total_ - trial_count_ + i) % cap;
+    }
 };
 
 } // namespace sOPT
\ No newline at end of file
@@ -5,6 +5,19 @@
 
 namespace sOPT {
 
+// checks if type has an objective function in the correct form ----------------
+template <typename T, typename = void>
+struct has_func : std::false_type {};
+
+template <typename T>
+struct has_func<
+    T,
+    std::void_t<decltype(std::declval<const T&>().func(std::declval<ecref<vecXd>>()))>>
+    : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_func_v = has_func<T>::value;
+
 // checks if type has a gradient attached in the correct form ------------------
 template <typename T, typename = void>
 struct has_gradient : std::false_type {};
@@ -33,6 +46,23 @@ struct has_hessian<T, std::void_t<decltype(std::declval<const T&>().hessian(
 template <typename T>
 inline constexpr bool has_hessian_v = has_hessian<T>::value;
 
+// checks if type has a sparse hessian in the correct form ---------------------
+// hessian_sparse(x, H) fills (at least) the lower triangle of H; the sparsity
+// pattern must not change between calls (explicit zeros are fine)
+template <typename T, typename = void>
+struct has_hessian_sparse : std::false_type {};
+
+template <typename T>
+struct has_hessian_sparse<
+    T,
+    std::void_t<decltype(std::declval<const T&>().hessian_sparse(
+        std::declval<ecref<vecXd>>(),
+        std::declval<spmatXd&>()
+    ))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_hessian_sparse_v = has_hessian_sparse<T>::value;
+
 // checks if type has a hessian-vector product in the correct form --------------
 template <typename T, typename = void>
 struct has_hessian_vector : std::false_type {};
@@ -49,6 +79,23 @@ struct has_hessian_vector<
 template <typename T>
 inline constexpr bool has_hessian_vector_v = has_hessian_vector<T>::value;
 
+// checks if type has a Hessian preconditioner in the correct form -------------
+// precondition(x, r, z) applies z = M(x)^{-1} r with M(x) SPD, M(x) ~ hessian(x)
+template <typename T, typename = void>
+struct has_precondition : std::false_type {};
+
+template <typename T>
+struct has_precondition<
+    T,
+    std::void_t<decltype(std::declval<const T&>().precondition(
+        std::declval<ecref<vecXd>>(),
+        std::declval<ecref<vecXd>>(),
+        std::declval<eref<vecXd>>()
+    ))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_precondition_v = has_precondition<T>::value;
+
 // checks if type has a residual function in the correct form ------------------
 template <typename T, typename = void>
 struct has_residual : std::false_type {};
@@ -79,4 +126,117 @@ struct has_jacobian<
 template <typename T>
 inline constexpr bool has_jacobian_v = has_jacobian<T>::value;
 
+// checks if type has a Jacobian-vector product in the correct form -------------
+// jvp(x, v, Jv): Jv = J(x) v in R^m for v in R^n
+template <typename T, typename = void>
+struct has_jvp : std::false_type {};
+
+template <typename T>
+struct has_jvp<
+    T,
+    std::void_t<decltype(std::declval<const T&>().jvp(
+        std::declval<ecref<vecXd>>(),
+        std::declval<ecref<vecXd>>(),
+        std::declval<eref<vecXd>>()
+    ))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_jvp_v = has_jvp<T>::value;
+
+// checks if type has a vector-Jacobian product in the correct form -------------
+// vjp(x, u, JTu): JTu = J(x)^T u in R^n for u in R^m
+template <typename T, typename = void>
+struct has_vjp : std::false_type {};
+
+template <typename T>
+struct has_vjp<
+    T,
+    std::void_t<decltype(std::declval<const T&>().vjp(
+        std::declval<ecref<vecXd>>(),
+        std::declval<ecref<vecXd>>(),
+        std::declval<eref<vecXd>>()
+    ))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_vjp_v = has_vjp<T>::value;
+
+// checks if type is a least-squares objective f = 1/2 ||r(x)||^2 -----------------
+// residual(x, r) fills r of length num_residuals() (fixed); jacobian(x, J) is optional
+template <typename T, typename = void>
+struct is_least_squares : std::false_type {};
+
+template <typename T>
+struct is_least_squares<
+    T,
+    std::void_t<decltype(static_cast<i32>(std::declval<const T&>().num_residuals()))>>
+    : std::bool_constant<has_residual_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_least_squares_v = is_least_squares<T>::value;
+
+// checks if type has an early-abort bounded function in the correct form ------
+// func_bounded(x, f_cap) may stop once f is known to exceed f_cap and return any
+// value > f_cap (e.g. the partial sum or inf)
+template <typename T, typename = void>
+struct has_func_bounded : std::false_type {};
+
+template <typename T>
+struct has_func_bounded<
+    T,
+    std::void_t<decltype(std::declval<const T&>().func_bounded(
+        std::declval<ecref<vecXd>>(),
+        std::declval<f64>()
+    ))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_func_bounded_v = has_func_bounded<T>::value;
+
+// checks if type has a low-fidelity function in the correct form -------------
+template <typename T, typename = void>
+struct has_func_lowfi : std::false_type {};
+
+template <typename T>
+struct has_func_lowfi<
+    T,
+    std::void_t<decltype(std::declval<const T&>().func_lowfi(
+        std::declval<ecref<vecXd>>()
+    ))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_func_lowfi_v = has_func_lowfi<T>::value;
+
+// checks if type can be restricted to a search ray x + alpha * p --------------
+// prepare_ray(x, p) precomputes ray quantities (held in mutable members),
+// func_along(alpha) then returns f(x + alpha * p)
+template <typename T, typename = void>
+struct has_ray_func : std::false_type {};
+
+template <typename T>
+struct has_ray_func<
+    T,
+    std::void_t<
+        decltype(std::declval<const T&>().prepare_ray(
+            std::declval<ecref<vecXd>>(),
+            std::declval<ecref<vecXd>>()
+        )),
+        decltype(std::declval<const T&>().func_along(std::declval<f64>()))>>
+    : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_ray_func_v = has_ray_func<T>::value;
+
+// checks if type has the ray directional derivative dfunc_along(alpha) ---------
+// returns \nabla f(x + alpha * p)^T p for the prepared ray
+template <typename T, typename = void>
+struct has_ray_dfunc : std::false_type {};
+
+template <typename T>
+struct has_ray_dfunc<
+    T,
+    std::void_t<decltype(std::declval<const T&>().dfunc_along(std::declval<f64>()))>>
+    : std::bool_constant<has_ray_func_v<T>> {};
+
+template <typename T>
+inline constexpr bool has_ray_dfunc_v = has_ray_dfunc<T>::value;
+
 } // namespace sOPT
@@ -34,14 +34,19 @@ struct Armijo {
         const f64 gTp = g.dot(p);
         if (!finite_neg(gTp)) return StepAttempt::line_search_failed; // require descent
 
+        oracle.begin_ray(x, p);
         x_next.resize(x.size());
         for (i32 k = 0; k < opt.ls.max_iters; k++) {
             x_next.noalias() = x + alpha * p; // candidate
-            if (!oracle.try_func(x_next, f_next)) return StepAttempt::eval_failed;
-            if (isfinite(f_next) && (f_next <= fx + c1 * alpha * gTp)) {
+            const f64 f_cap = fx + c1 * alpha * gTp;
+            if (!oracle.try_func_along(alpha, x_next, f_next, f_cap)) {
+                return StepAttempt::eval_failed;
+            }
+            if (isfinite(f_next) && (f_next <= f_cap)) {
                 return StepAttempt::accepted;
             }
             alpha *= rho;
+            ++oracle.ls_stats().backtracks;
             if (!finite_pos(alpha)) return StepAttempt::line_search_failed;
         }
 
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/vecdefs.hpp"
+#include "sOPT/step_size/step_attempt.hpp"
+
+#include <vector>
+
+namespace sOPT {
+
+// Armijo backtracking with low-fidelity screening.
+// Trials are first checked against the low-fidelity model relative to its own
+// value at x:
+// f_{lo}(x_k + \alpha p_k) \leq f_{lo}(x_k) + c_1 \alpha \nabla f_k^T p_k
+// and the full objective is evaluated only on trials that pass the screen.
+// A screened trial rejected by the full check is recorded as a mismatch. If the
+// search runs out of trials after screen rejections, the screen-rejected trials
+// are re-checked in full, largest first; trials already evaluated in full are not
+// repeated. Each re-check is a screen outcome, and a full pass is a mismatch. Once
+// the mismatch rate exceeds opt.lowfi.max_mismatch_rate the strategy reverts to
+// plain Armijo. Without a func_lowfi trait this is plain Armijo.
+struct ArmijoLowFi {
+    template <typename OracleT>
+    StepAttempt operator()(
+        OracleT& oracle,
+        ecref<vecXd> x,
+        f64 fx,
+        ecref<vecXd> g,
+        ecref<vecXd> p,
+        f64& alpha,
+        vecXd& x_next,
+        f64& f_next,
+        const Options& opt
+    ) const {
+        const f64 c1 = opt.ls.c1;
+        const f64 rho = opt.ls.rho;
+        alpha = opt.ls.alpha0;
+        if (!finite_pos(alpha)) return StepAttempt::line_search_failed;
+        if (!in_op(rho, 0.0, 1.0)) return StepAttempt::line_search_failed;
+        if (!in_op(c1, 0.0, 1.0)) return StepAttempt::line_search_failed;
+
+        const f64 gTp = g.dot(p);
+        if (!finite_neg(gTp)) return StepAttempt::line_search_failed; // require descent
+
+        f64 flo_x = 0.0;
+        bool screen = oracle.lowfi_trusted() && oracle.try_func_lowfi(x, flo_x);
+
+        oracle.begin_ray(x, p);
+        x_next.resize(x.size());
+        // full Armijo check of x_next = x + alpha p; false if the evaluation failed
+        auto full_check = [&](bool& ok) {
+            const f64 f_cap = fx + c1 * alpha * gTp;
+            if (!oracle.try_func_along(alpha, x_next, f_next, f_cap)) return false;
+            ok = isfinite(f_next) && (f_next <= f_cap);
+            return true;
+        };
+
+        std::vector<f64> rejected; // trials rejected by the screen alone, in order
+        for (i32 k = 0; k < opt.ls.max_iters; k++) {
+            x_next.noalias() = x + alpha * p; // candidate
+            if (screen) {
+                f64 flo = 0.0;
+                const bool lo_ok = oracle.try_func_lowfi(x_next, flo)
+                                   && (flo <= flo_x + c1 * alpha * gTp);
+                if (!lo_ok) { // cheap rejection
+                    rejected.push_back(alpha);
+                    alpha *= rho;
+                    ++oracle.ls_stats().backtracks;
+                    if (!finite_pos(alpha)) break;
+                    continue;
+                }
+            }
+
+            bool ok = false;
+            if (!full_check(ok)) return StepAttempt::eval_failed;
+            if (screen) {
+                oracle.record_lowfi_screen(!ok);
+                screen = oracle.lowfi_trusted();
+            }
+            if (ok) return StepAttempt::accepted;
+
+            alpha *= rho;
+            ++oracle.ls_stats().backtracks;
+            if (!finite_pos(alpha)) break;
+        }
+
+        // Out of trials: re-check the screen-rejected trials in full. A full pass
+        // means the screen was wrong and counts as a mismatch.
+        for (const f64 a : rejected) {
+            alpha = a;
+            x_next.noalias() = x + alpha * p;
+            bool ok = false;
+            if (!full_check(ok)) return StepAttempt::eval_failed;
+            oracle.record_lowfi_screen(ok);
+            if (ok) return StepAttempt::accepted;
+        }
+        return StepAttempt::line_search_failed;
+    }
+};
+
+} // namespace sOPT
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/vecdefs.hpp"
+#include "sOPT/step_size/armijo.hpp"
+#include "sOPT/step_size/step_attempt.hpp"
+
+namespace sOPT {
+
+// Exact step along p from the local quadratic model:
+// \alpha^* = -\frac{\nabla f_k^T p_k}{p_k^T \nabla^2 f_k\, p_k}
+// Costs one Hv product (user Hv, Hessian-backed Hv, or FD Hv via the oracle) and
+// one function evaluation for the Armijo check. Falls back to Armijo backtracking
+// when the curvature along p is non-positive or the model step is rejected.
+// alpha^* replaces the unit-step probe, so opt.ls.try_full_step does not apply.
+struct ExactCurvature {
+    static constexpr bool try_full_step = false;
+
+    template <typename OracleT>
+    StepAttempt operator()(
+        OracleT& oracle,
+        ecref<vecXd> x,
+        f64 fx,
+        ecref<vecXd> g,
+        ecref<vecXd> p,
+        f64& alpha,
+        vecXd& x_next,
+        f64& f_next,
+        const Options& opt
+    ) const {
+        const f64 c1 = opt.ls.c1;
+        if (!in_op(c1, 0.0, 1.0)) return StepAttempt::line_search_failed;
+
+        const f64 gTp = g.dot(p);
+        if (!finite_neg(gTp)) return StepAttempt::line_search_failed; // require descent
+
+        f64 pHp = 0.0;
+        if (!oracle.try_curvature_along(x, p, pHp)) return StepAttempt::eval_failed;
+
+        if (finite_pos(pHp)) {
+            alpha = -gTp / pHp;
+            if (finite_pos(alpha)) {
+                oracle.begin_ray(x, p);
+                x_next.resize(x.size());
+                x_next.noalias() = x + alpha * p;
+                const f64 f_cap = fx + c1 * alpha * gTp;
+                if (!oracle.try_func_along(alpha, x_next, f_next, f_cap)) {
+                    return StepAttempt::eval_failed;
+                }
+                if (isfinite(f_next) && (f_next <= f_cap)) {
+                    return StepAttempt::accepted;
+                }
+            }
+        }
+
+        // non-positive curvature or model step rejected
+        return Armijo{}(oracle, x, fx, g, p, alpha, x_next, f_next, opt);
+    }
+};
+
+} // namespace sOPT
@@ -23,10 +23,13 @@ struct FixedStep {
         (void)fx;
 
         alpha = opt.ls.alpha_fixed;
+        oracle.begin_ray(x, p);
         x_next.resize(x.size());
         x_next.noalias() = x + alpha * p;
 
-        if (!oracle.try_func(x_next, f_next)) return StepAttempt::eval_failed;
+        if (!oracle.try_func_along(alpha, x_next, f_next)) {
+            return StepAttempt::eval_failed;
+        }
 
         return isfinite(f_next) ? StepAttempt::accepted : StepAttempt::eval_failed;
     }
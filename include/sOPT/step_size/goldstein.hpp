@@ -32,10 +32,13 @@ struct Goldstein {
         alpha = opt.ls.alpha0;
         if (!finite_pos(alpha)) return StepAttempt::line_search_failed;
 
+        oracle.begin_ray(x, p);
         x_next.resize(x.size());
         for (i32 k = 0; k < opt.ls.max_iters; k++) {
             x_next.noalias() = x + alpha * p;
-            if (!oracle.try_func(x_next, f_next)) return StepAttempt::eval_failed;
+            if (!oracle.try_func_along(alpha, x_next, f_next)) {
+                return StepAttempt::eval_failed;
+            }
             if (!isfinite(f_next)) return StepAttempt::eval_failed;
 
             const f64 upper = f0 + c * alpha * g0p;
@@ -44,14 +47,18 @@ struct Goldstein {
             if (f_next > upper) {
                 ahi = alpha;
                 alpha = 0.5 * (alo + ahi); // bisection
+                ++oracle.ls_stats().backtracks;
                 continue;
             }
             if (f_next < lower) {
                 alo = alpha;
-                if (isfinite(ahi))
+                if (isfinite(ahi)) {
                     alpha = 0.5 * (alo + ahi); // bisection
-                else
+                    ++oracle.ls_stats().zoom_iters;
+                } else {
                     alpha *= 2.0;
+                    ++oracle.ls_stats().expansions;
+                }
                 continue;
             }
 
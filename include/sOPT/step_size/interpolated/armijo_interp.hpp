@@ -35,13 +35,16 @@ struct ArmijoInterp {
         const f64 gTp = g.dot(p);
         if (!finite_neg(gTp)) return StepAttempt::line_search_failed;
 
+        oracle.begin_ray(x, p);
         x_next.resize(x.size());
         bool has_prev = false;
         f64 alpha_prev = 0.0;
         f64 f_prev = fx;
         for (i32 k = 0; k < opt.ls.max_iters; ++k) {
             x_next.noalias() = x + alpha * p;
-            if (!oracle.try_func(x_next, f_next)) return StepAttempt::eval_failed;
+            if (!oracle.try_func_along(alpha, x_next, f_next)) {
+                return StepAttempt::eval_failed;
+            }
             if (f_next <= fx + c1 * alpha * gTp) return StepAttempt::accepted;
 
             f64 alpha_next = rho * alpha; // bisection/geometric fallback
@@ -74,6 +77,7 @@ struct ArmijoInterp {
             f_prev = f_next;
             has_prev = true;
             alpha = alpha_next;
+            ++oracle.ls_stats().backtracks;
         }
 
         return StepAttempt::line_search_failed;
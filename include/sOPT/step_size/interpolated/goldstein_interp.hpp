@@ -32,6 +32,7 @@ struct GoldsteinInterp {
         if (!finite_pos(alpha)) return StepAttempt::line_search_failed;
         const f64 alpha_max = opt.ls.alpha_max;
 
+        oracle.begin_ray(x, p);
         x_next.resize(x.size());
         f64 alo = 0.0;
         f64 ahi = inf<f64>;
@@ -42,7 +43,9 @@ struct GoldsteinInterp {
         i32 bracket_steps = 0;
         for (i32 k = 0; k < opt.ls.max_iters; k++) {
             x_next.noalias() = x + alpha * p;
-            if (!oracle.try_func(x_next, f_next)) return StepAttempt::eval_failed;
+            if (!oracle.try_func_along(alpha, x_next, f_next)) {
+                return StepAttempt::eval_failed;
+            }
 
             const f64 upper = f0 + c * alpha * g0p;
             const f64 lower = f0 + (1.0 - c) * alpha * g0p;
@@ -71,11 +74,13 @@ struct GoldsteinInterp {
                 if (!std::isfinite(cand)) cand = 0.5 * (alo + ahi);
                 alpha = detail::clamp_pad(cand, alo, ahi);
                 ++bracket_steps;
+                ++oracle.ls_stats().zoom_iters;
                 continue;
             }
 
             if (has_hi) {
                 alpha = 0.5 * (alo + ahi);
+                ++oracle.ls_stats().backtracks;
                 continue;
             }
 
@@ -83,6 +88,7 @@ struct GoldsteinInterp {
                 alpha = std::min(alpha * 2.0, alpha_max);
             else
                 alpha *= 2.0;
+            ++oracle.ls_stats().expansions;
         }
         return StepAttempt::line_search_failed;
     }
@@ -34,19 +34,17 @@ inline StepAttempt wolfe_interp_impl(
     const f64 g0p = g0.dot(p);
     if (!finite_neg(g0p)) return StepAttempt::line_search_failed;
 
-    vecXd g_trial(n);
     vecXd xt_zoom(n);
+    oracle.begin_ray(x, p);
 
     // phi and phi' in Nocedal
     auto phi = [&](f64 a, vecXd& xt, f64& ft) -> StepAttempt {
         xt.noalias() = x + a * p;
-        if (!oracle.try_func(xt, ft)) return StepAttempt::eval_failed;
+        if (!oracle.try_func_along(a, xt, ft)) return StepAttempt::eval_failed;
         return isfinite(ft) ? StepAttempt::accepted : StepAttempt::eval_failed;
     };
-    auto dphi = [&](ecref<vecXd> xt, f64& dphi_val) -> StepAttempt {
-        if (!oracle.try_gradient(xt, g_trial)) return StepAttempt::eval_failed;
-        if (!g_trial.allFinite()) return StepAttempt::eval_failed;
-        dphi_val = g_trial.dot(p);
+    auto dphi = [&](f64 a, ecref<vecXd> xt, f64& dphi_val) -> StepAttempt {
+        if (!oracle.try_dfunc_along(a, xt, p, dphi_val)) return StepAttempt::eval_failed;
         return isfinite(dphi_val) ? StepAttempt::accepted : StepAttempt::eval_failed;
     };
     auto wolfe_ok = [&](f64 a, f64 ft, f64 dft) -> bool {
@@ -62,6 +60,7 @@ inline StepAttempt wolfe_interp_impl(
         if (!isfinite(dlo)) return StepAttempt::line_search_failed;
 
         for (i32 k = 0; k < opt.ls.max_iters; k++) {
+            ++oracle.ls_stats().zoom_iters;
             const f64 aj = detail::interpolated_zoom_trial(alo, flo, dlo, ahi, fhi);
             const StepAttempt phi_status = phi(aj, xt_zoom, f_next);
             if (phi_status != StepAttempt::accepted) return phi_status;
@@ -73,7 +72,7 @@ inline StepAttempt wolfe_interp_impl(
             }
 
             f64 dphi_j = 0.0;
-            const StepAttempt dphi_status = dphi(xt_zoom, dphi_j);
+            const StepAttempt dphi_status = dphi(aj, xt_zoom, dphi_j);
             if (dphi_status != StepAttempt::accepted) return dphi_status;
 
             if (wolfe_ok(aj, f_next, dphi_j)) {
@@ -111,7 +110,7 @@ inline StepAttempt wolfe_interp_impl(
         }
 
         f64 dphi_a = 0.0;
-        const StepAttempt dphi_status = dphi(x_next, dphi_a);
+        const StepAttempt dphi_status = dphi(alpha, x_next, dphi_a);
         if (dphi_status != StepAttempt::accepted) return dphi_status;
 
         if (wolfe_ok(alpha, f_next, dphi_a)) return StepAttempt::accepted;
@@ -122,6 +121,7 @@ inline StepAttempt wolfe_interp_impl(
         f_prev = f_next;
         d_prev = dphi_a;
         alpha = std::min(alpha * 2.0, alpha_max);
+        ++oracle.ls_stats().expansions;
     }
     return StepAttempt::line_search_failed;
 }
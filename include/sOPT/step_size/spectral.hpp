@@ -0,0 +1,79 @@
+#pragma once
+
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/typedefs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace sOPT {
+
+// Line-search-free step rules for gradient_descent. alpha_k comes from the last
+// step s = x_k - x_{k-1} and gradient change y = g_k - g_{k-1} instead of trial
+// evaluations of f, so gradient_descent keeps (s, y) and runs these in place of
+// run_step. They are not step strategies for the other solvers.
+
+// Barzilai-Borwein (spectral) step, opt.gd.bb:
+// \alpha^{BB1}_k = \frac{s^T s}{s^T y}, \qquad \alpha^{BB2}_k = \frac{s^T y}{y^T y}
+// ref: barzilai1988two, raydan1997barzilai
+struct BarzilaiBorwein {};
+
+// Malitsky-Mishchenko adaptive step from local Lipschitz estimates:
+// \alpha_k = \min\Big(\sqrt{1 + \theta_{k-1}}\, \alpha_{k-1},
+//     \frac{\|s\|}{2 \|y\|}\Big), \qquad \theta_k = \alpha_k / \alpha_{k-1}
+// ref: malitsky2020adaptive
+struct AdaptiveLipschitz {};
+
+template <typename T>
+inline constexpr bool is_step_rule_v
+    = std::is_same_v<T, BarzilaiBorwein> || std::is_same_v<T, AdaptiveLipschitz>;
+
+namespace detail {
+
+// alpha_0 before any (s, y) pair exists
+inline f64 step_rule_alpha_init(f64 gnorm, f64 xnorm, const GradientDescentOptions& gd) {
+    if (gd.alpha_init > 0.0) return gd.alpha_init;
+    return std::clamp(1e-4 * std::max(1.0, xnorm) / gnorm, gd.alpha_min, gd.alpha_max);
+}
+
+// BB1/BB2 from s^T s, s^T y, y^T y; k = iteration (alternating: bb1 on odd k).
+// s^T y <= 0 (non-convex along s) falls back to ||s|| / ||y||.
+inline f64 bb_alpha(
+    f64 sTs,
+    f64 sTy,
+    f64 yTy,
+    i32 k,
+    f64 alpha_prev,
+    const GradientDescentOptions& gd
+) {
+    f64 alpha = 0.0;
+    if (!(sTy > 0.0)) {
+        alpha = std::sqrt(sTs / yTy);
+    } else {
+        const bool long_step = gd.bb == BBStep::bb1
+            || (gd.bb == BBStep::alternating && (k % 2 == 1));
+        alpha = long_step ? sTs / sTy : sTy / yTy;
+    }
+    if (std::isnan(alpha)) return alpha_prev; // s = y = 0
+    return std::clamp(alpha, gd.alpha_min, gd.alpha_max);
+}
+
+// Malitsky-Mishchenko; theta = alpha_{k-1} / alpha_{k-2} (inf at k = 1)
+inline f64 adaptive_lipschitz_alpha(
+    f64 sTs,
+    f64 yTy,
+    f64 alpha_prev,
+    f64 theta,
+    const GradientDescentOptions& gd
+) {
+    const f64 growth = std::sqrt(1.0 + theta) * alpha_prev;
+    const f64 lipschitz = (yTy > 0.0) ? 0.5 * std::sqrt(sTs / yTy) : inf<f64>;
+    const f64 alpha = std::min(growth, lipschitz);
+    if (!(alpha > 0.0)) return alpha_prev;
+    return std::clamp(alpha, gd.alpha_min, gd.alpha_max);
+}
+
+} // namespace detail
+} // namespace sOPT
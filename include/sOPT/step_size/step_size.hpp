@@ -4,8 +4,11 @@
 #include "sOPT/step_size/try_full.hpp"
 
 #include "sOPT/step_size/armijo.hpp"
+#include "sOPT/step_size/armijo_lowfi.hpp"
+#include "sOPT/step_size/exact_curvature.hpp"
 #include "sOPT/step_size/fixed_step.hpp"
 #include "sOPT/step_size/goldstein.hpp"
+#include "sOPT/step_size/spectral.hpp"
 #include "sOPT/step_size/wolfe.hpp"
 
 #include "sOPT/step_size/interpolated/interpolated_step_size.hpp"
\ No newline at end of file
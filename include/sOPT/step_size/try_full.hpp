@@ -9,6 +9,18 @@
 
 namespace sOPT {
 
+// strategies whose first trial replaces the unit step opt out of TryFull with
+// static constexpr bool try_full_step = false;
+template <typename Step, typename = void>
+struct uses_try_full : std::true_type {};
+
+template <typename Step>
+struct uses_try_full<Step, std::void_t<decltype(Step::try_full_step)>>
+    : std::bool_constant<Step::try_full_step> {};
+
+template <typename Step>
+inline constexpr bool uses_try_full_v = uses_try_full<Step>::value;
+
 // never pass TryFull<step_strategy>{} explicitly, control with
 // opt.ls.try_full_step = true/false
 template <typename InnerStep>
@@ -34,14 +46,19 @@ struct TryFull {
 
         // only try alpha=1 if p is a descent direction
         if (g0p < 0.0) {
+            oracle.begin_ray(x, p);
             alpha = 1.0;
             x_next.resize(x.size());
             x_next.noalias() = x + alpha * p;
-            if (!oracle.try_func(x_next, f_next)) return StepAttempt::eval_failed;
+            const f64 f_cap = f0 + opt.ls.c1 * alpha * g0p;
+            if (!oracle.try_func_along(alpha, x_next, f_next, f_cap)) {
+                return StepAttempt::eval_failed;
+            }
 
-            if (isfinite(f_next) && (f_next <= f0 + opt.ls.c1 * alpha * g0p)) {
+            if (isfinite(f_next) && (f_next <= f_cap)) {
                 return StepAttempt::accepted;
             }
+            ++oracle.ls_stats().full_step_rejects;
         }
 
         const auto inner_result = inner(oracle, x, f0, g0, p, alpha, x_next, f_next, opt);
@@ -35,19 +35,21 @@ inline StepAttempt wolfe_impl(
 
     const f64 alpha_max = opt.ls.alpha_max;
 
-    vecXd g_trial(n);
     vecXd xt_zoom(n);
+    oracle.begin_ray(x, p);
 
     // phi and phi' in Nocedal
+    // phi probes are bounded by the Armijo cap: any value above it is only used
+    // as a rejection (fhi is never read), so an early-aborted value is safe here
     auto phi = [&](f64 a, vecXd& xt, f64& ft) -> StepAttempt {
         xt.noalias() = x + a * p;
-        if (!oracle.try_func(xt, ft)) return StepAttempt::eval_failed;
-        return isfinite(ft) ? StepAttempt::accepted : StepAttempt::eval_failed;
+        const f64 f_cap = f0 + c1 * a * g0p;
+        if (!oracle.try_func_along(a, xt, ft, f_cap)) return StepAttempt::eval_failed;
+        return (isfinite(ft) || ft > f_cap) ? StepAttempt::accepted
+                                            : StepAttempt::eval_failed;
     };
-    auto dphi = [&](ecref<vecXd> xt, f64& dphi_val) -> StepAttempt {
-        if (!oracle.try_gradient(xt, g_trial)) return StepAttempt::eval_failed;
-        if (!g_trial.allFinite()) return StepAttempt::eval_failed;
-        dphi_val = g_trial.dot(p);
+    auto dphi = [&](f64 a, ecref<vecXd> xt, f64& dphi_val) -> StepAttempt {
+        if (!oracle.try_dfunc_along(a, xt, p, dphi_val)) return StepAttempt::eval_failed;
         return isfinite(dphi_val) ? StepAttempt::accepted : StepAttempt::eval_failed;
     };
     auto wolfe_ok = [&](f64 a, f64 ft, f64 dft) -> bool {
@@ -64,6 +66,7 @@ inline StepAttempt wolfe_impl(
         if (!isfinite(d_lo)) return StepAttempt::line_search_failed;
 
         for (i32 k = 0; k < opt.ls.max_iters; k++) {
+            ++oracle.ls_stats().zoom_iters;
             const f64 aj = 0.5 * (alo + ahi); // bisection
 
             const StepAttempt phi_status = phi(aj, xt_zoom, f_next);
@@ -76,7 +79,7 @@ inline StepAttempt wolfe_impl(
             }
 
             f64 dphi_j = 0.0;
-            const StepAttempt dphi_status = dphi(xt_zoom, dphi_j);
+            const StepAttempt dphi_status = dphi(aj, xt_zoom, dphi_j);
             if (dphi_status != StepAttempt::accepted) return dphi_status;
 
             if (wolfe_ok(aj, f_next, dphi_j)) {
@@ -114,7 +117,7 @@ inline StepAttempt wolfe_impl(
         }
 
         f64 dphi_a = 0.0;
-        const StepAttempt dphi_status = dphi(x_next, dphi_a);
+        const StepAttempt dphi_status = dphi(alpha, x_next, dphi_a);
         if (dphi_status != StepAttempt::accepted) return dphi_status;
 
         if (wolfe_ok(alpha, f_next, dphi_a)) {
@@ -128,6 +131,7 @@ inline StepAttempt wolfe_impl(
         f_prev = f_next;
         d_prev = dphi_a;
         alpha = std::min(2.0 * alpha, alpha_max);
+        ++oracle.ls_stats().expansions;
         if (alpha == a_prev) return StepAttempt::line_search_failed;
     }
     return StepAttempt::line_search_failed;
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/vecdefs.hpp"
+#include "sOPT/trust_region/tr_step.hpp"
+
+#include <Eigen/Cholesky>
+#include <algorithm>
+
+namespace sOPT {
+
+// Dogleg trust-region step (dense Hessian)
+// ref: nocedal2006numerical pp.73-76
+//
+// \begin{aligned}
+// p^U &= -\frac{g^T g}{g^T B g} g, \quad p^N = -B^{-1} g \\
+// p(\tau) &= p^U + \tau (p^N - p^U), \quad \|p(\tau)\| = \Delta
+// \end{aligned}
+//
+// B = H if H is SPD, otherwise B = H + lambda I with lambda doubled from
+// max(-min_i H_ii, 0) + 1e-3 ||H||_1 until the Cholesky factorization succeeds (in the
+// same LLT storage). H, B's factor, p^N and p^U are computed once per new x;
+// re-solves after a rejected step only walk the path again. MoreSorensen solves the
+// subproblem with the true H instead.
+struct Dogleg {
+    template <typename OracleT>
+    detail::EvalStatus solve(
+        OracleT& oracle,
+        const Options& opt,
+        ecref<vecXd> x,
+        ecref<vecXd> g,
+        f64 delta,
+        bool new_x,
+        eref<vecXd> p,
+        TRStep& step
+    ) {
+        (void)opt;
+        const i32 n = static_cast<i32>(g.size());
+        step = TRStep{};
+        if (new_x) {
+            if (H_.rows() != n) {
+                H_.resize(n, n);
+                for (vecXd* v : {&pN_, &pU_, &d_, &Hp_}) v->resize(n);
+            }
+            const detail::EvalStatus hess_status = detail::eval_hess(oracle, x, H_);
+            if (hess_status != detail::EvalStatus::ok) return hess_status;
+
+            // model hessian B = H + lambda I, lambda > 0 only if H is not SPD
+            const i32 max_tries = 60;
+            const f64 H_norm1 = H_.cwiseAbs().colwise().sum().maxCoeff();
+            lambda_ = 0.0;
+            spd_ = false;
+            for (i32 t = 0; t < max_tries && !spd_; t++) {
+                if (t == 1) {
+                    lambda_ = std::max(-H_.diagonal().minCoeff(), 0.0)
+                            + 1e-3 * std::max(H_norm1, 1.0);
+                } else if (t > 1) {
+                    lambda_ *= 2.0;
+                }
+                llt_.compute(H_ + lambda_ * matXd::Identity(n, n)); // B = L * L^T
+                ++step.inner_iters;
+                if (llt_.info() != eig::Success) continue;
+                pN_.noalias() = -g;
+                llt_.solveInPlace(pN_);
+                spd_ = pN_.allFinite();
+            }
+            Hp_.noalias() = H_ * g;
+            gBg_ = g.dot(Hp_) + lambda_ * g.squaredNorm();
+            if (gBg_ > 0.0) pU_.noalias() = (-g.squaredNorm() / gBg_) * g;
+        }
+        step.neg_curvature = (lambda_ > 0.0);
+
+        const f64 gnorm = g.norm();
+        if (spd_ && pN_.norm() <= delta) { // full Newton step
+            p = pN_;
+        } else if (!spd_ || pU_.norm() >= delta) { // Cauchy point
+            f64 tau = 1.0;
+            if (gBg_ > 0.0) tau = std::min(gnorm * gnorm * gnorm / (delta * gBg_), 1.0);
+            p.noalias() = (-tau * delta / gnorm) * g;
+            step.on_boundary = (tau == 1.0);
+        } else { // dogleg segment p^U -> p^N crosses the boundary
+            d_.noalias() = pN_ - pU_;
+            const f64 uu = pU_.squaredNorm();
+            const f64 tau = tr_boundary_tau(uu, pU_.dot(d_), d_.squaredNorm(), delta);
+            p.noalias() = pU_ + tau * d_;
+            step.on_boundary = true;
+        }
+
+        // pred = -(g^T p + 0.5 p^T B p)
+        Hp_.noalias() = H_ * p;
+        Hp_ += lambda_ * p;
+        step.pred = -(g.dot(p) + 0.5 * p.dot(Hp_));
+        step.norm = p.norm();
+        return p.allFinite() ? detail::EvalStatus::ok : detail::EvalStatus::eval_failed;
+    }
+
+  private:
+    matXd H_;             // hessian at the current x
+    eig::LLT<matXd> llt_; // Cholesky factor of B
+    vecXd pN_;            // Newton step
+    vecXd pU_;            // unconstrained minimizer along -g
+    vecXd d_;             // pN_ - pU_
+    vecXd Hp_;            // H g, then B p
+    f64 gBg_ = 0.0;       // g^T B g
+    f64 lambda_ = 0.0;    // B = H + lambda I
+    bool spd_ = false;    // B factored and pN_ valid
+};
+
+} // namespace sOPT
@@ -0,0 +1,372 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/vecdefs.hpp"
+#include "sOPT/trust_region/tr_step.hpp"
+
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+
+namespace sOPT {
+
+// Limited-memory SR1 trust-region model
+// ref: nocedal2006numerical pp.144-147, pp.181-184, brust2017solving
+//
+// \begin{aligned}
+// B &= \gamma I + \Psi N^{-1} \Psi^T, \quad \Psi = Y - \gamma S, \quad
+//     N = D + L + L^T - \gamma S^T S \\
+//   &= P_\parallel \Lambda P_\parallel^T + \gamma (I - P_\parallel P_\parallel^T),
+//     \quad P_\parallel = \Psi W
+// \end{aligned}
+//
+// with D + L + L^T the symmetrized S^T Y (L strictly lower in time order). W (m x r)
+// comes from two small eigen decompositions, of \Psi^T \Psi = V D_\psi V^T (rank r
+// after dropping null directions) and of D_\psi^{1/2} V^T N^{-1} V D_\psi^{1/2} =
+// U (\Lambda - \gamma I) U^T, so P_\parallel = \Psi V D_\psi^{-1/2} U has orthonormal
+// columns and is never formed. The subproblem is solved exactly in these
+// eigen-coordinates: with g_\parallel = P_\parallel^T g,
+//
+// p(\sigma) = -P_\parallel (\Lambda + \sigma I)^{-1} g_\parallel
+//             - (\gamma + \sigma)^{-1} (g - P_\parallel g_\parallel)
+//
+// and a scalar Newton iteration on 1/||p(\sigma)|| = 1/\Delta (O(m) per iteration).
+// The hard case is completed along P_\parallel e_min. Per outer iteration the cost
+// is a handful of n x m GEMVs; memory is 2 n m plus m x m Gram matrices.
+//
+// Pairs from every trial step, rejected ones included, enter through update() (called
+// by trust_region). A pair is skipped unless |s^T (y - B s)| >= sr1_skip_tol ||s||
+// ||y - B s||; B may stay indefinite. \gamma = y^T y / s^T y of the newest pair with
+// s^T y > 0. \gamma changes from step to step, and N built with a new \gamma can be
+// nearly singular against old pairs, which puts spurious large eigenvalues into B. A
+// model is therefore accepted only if cond(N) <= sr1_cond_max: the new \gamma is
+// tried, then the previous one, then the oldest pair is dropped and both are tried
+// again (no pairs left: B = \gamma I).
+struct LSR1 {
+    template <typename OracleT>
+    detail::EvalStatus solve(
+        OracleT& oracle,
+        const Options& opt,
+        ecref<vecXd> x,
+        ecref<vecXd> g,
+        f64 delta,
+        bool new_x,
+        eref<vecXd> p,
+        TRStep& step
+    ) {
+        (void)oracle; // the model needs no Hessian information
+        (void)x;
+        const i32 n = static_cast<i32>(g.size());
+        if (S_.rows() != n) reset(n, opt.tr.sr1_memory);
+        step = TRStep{};
+        if (new_x || dirty_) { // dirty_: a pair arrived from a rejected step
+            if (dirty_) build(opt.tr.sr1_cond_max);
+            project(g);
+        }
+        const i32 L = len_;
+        const i32 r = r_;
+        const f64 gnorm = std::sqrt(gg_);
+
+        // ||p(sigma)||^2 over the eigen-coordinates (perp block has eigenvalue gamma)
+        const auto pnorm2 = [&](f64 sg) {
+            f64 v = gperp2_ / ((gamma_ + sg) * (gamma_ + sg));
+            for (i32 i = 0; i < r; i++) {
+                const f64 d = lam_[i] + sg;
+                v += gpar_[i] * gpar_[i] / (d * d);
+            }
+            return v;
+        };
+        const auto dpnorm2 = [&](f64 sg) { // -0.5 d/dsigma ||p(sigma)||^2
+            const f64 dg = gamma_ + sg;
+            f64 v = gperp2_ / (dg * dg * dg);
+            for (i32 i = 0; i < r; i++) {
+                const f64 d = lam_[i] + sg;
+                v += gpar_[i] * gpar_[i] / (d * d * d);
+            }
+            return v;
+        };
+
+        f64 lam_min = gamma_;
+        i32 i_min = -1;
+        for (i32 i = 0; i < r; i++) {
+            if (lam_[i] < lam_min) {
+                lam_min = lam_[i];
+                i_min = i;
+            }
+        }
+        step.neg_curvature = (lam_min < 0.0);
+
+        f64 sigma = 0.0;
+        bool hard_case = false;
+        if (!(lam_min > 0.0 && pnorm2(0.0) <= delta * delta)) {
+            f64 lo = std::max(0.0, -lam_min);
+            f64 hi = lo + gnorm / delta; // ||p(hi)|| <= delta
+            const f64 w_tol = 1e-12 * gnorm;
+            if (i_min >= 0 && lam_min <= 0.0 && std::abs(gpar_[i_min]) <= w_tol) {
+                // g has no component along the most negative directions: p(lo) may
+                // already fit inside the region
+                f64 v = gperp2_ / ((gamma_ + lo) * (gamma_ + lo));
+                bool pole = false;
+                for (i32 i = 0; i < r; i++) {
+                    const f64 d = lam_[i] + lo;
+                    if (d <= 0.0) {
+                        pole = pole || std::abs(gpar_[i]) > w_tol;
+                        continue;
+                    }
+                    v += gpar_[i] * gpar_[i] / (d * d);
+                }
+                hard_case = !pole && v <= delta * delta;
+            }
+            if (hard_case) {
+                sigma = lo;
+            } else {
+                // safeguarded Newton on 1/||p(sigma)|| = 1/delta from the left
+                sigma = (lam_min <= 0.0) ? lo + 1e-12 * (1.0 + lo) : 0.0;
+                for (i32 it = 0; it < 100; it++) {
+                    ++step.inner_iters;
+                    const f64 vv = pnorm2(sigma);
+                    const f64 vn = std::sqrt(vv);
+                    if (std::abs(vn - delta) <= 1e-10 * delta) break;
+                    if (vn > delta) {
+                        lo = sigma;
+                    } else {
+                        hi = sigma;
+                    }
+                    f64 next = sigma + (vn - delta) / delta * vv / dpnorm2(sigma);
+                    if (!(next > lo && next < hi)) next = 0.5 * (lo + hi);
+                    if (next == sigma) break;
+                    sigma = next;
+                }
+            }
+            step.on_boundary = true;
+        }
+
+        // eigen-coordinates of p, then model values without touching n-vectors
+        const f64 inv_perp = 1.0 / (gamma_ + sigma);
+        a_.resize(r);
+        for (i32 i = 0; i < r; i++) {
+            const f64 d = lam_[i] + sigma;
+            a_[i] = (d > 0.0) ? -gpar_[i] / d : 0.0;
+        }
+        if (hard_case) { // a_[i_min] = 0: step along P_par e_min to the boundary
+            const f64 zz = a_.squaredNorm() + gperp2_ * inv_perp * inv_perp;
+            a_[i_min] = tr_boundary_tau(zz, 0.0, 1.0, delta);
+        }
+        const f64 gTp = gpar_.head(r).dot(a_) - gperp2_ * inv_perp;
+        f64 pBp = gamma_ * gperp2_ * inv_perp * inv_perp;
+        for (i32 i = 0; i < r; i++) pBp += lam_[i] * a_[i] * a_[i];
+        step.pred = -(gTp + 0.5 * pBp);
+        step.norm = std::sqrt(a_.squaredNorm() + gperp2_ * inv_perp * inv_perp);
+
+        // p = \Psi W (a + inv_perp g_par) - inv_perp g
+        p.noalias() = -inv_perp * g;
+        if (r > 0) {
+            c_.noalias() = W_ * (a_ + inv_perp * gpar_.head(r));
+            p.noalias() += Y_.leftCols(L) * c_;
+            p.noalias() -= gamma_ * (S_.leftCols(L) * c_);
+        }
+        return p.allFinite() ? detail::EvalStatus::ok : detail::EvalStatus::eval_failed;
+    }
+
+    // secant pair from a trial step: s = p_k, y = g(x_k + p_k) - g_k
+    void update(const Options& opt, ecref<vecXd> s, ecref<vecXd> y) {
+        const f64 sy = s.dot(y);
+        const f64 ss = s.squaredNorm();
+        const f64 yy = y.squaredNorm();
+        if (sy > 0.0 && finite_pos(yy / sy)) gamma_new_ = yy / sy;
+        dirty_ = true;
+        if (m_ == 0) return;
+
+        const i32 L = len_;
+        Sts_.noalias() = S_.leftCols(L).transpose() * s;
+        Yts_.noalias() = Y_.leftCols(L).transpose() * s;
+        Sty_.noalias() = S_.leftCols(L).transpose() * y;
+        Yty_.noalias() = Y_.leftCols(L).transpose() * y;
+
+        // u = y - B s with the model the step was taken from
+        u_.noalias() = y - gamma_ * s;
+        if (L > 0 && Ninv_.rows() == L) {
+            c_.noalias() = Ninv_ * (Yts_ - gamma_ * Sts_);
+            u_.noalias() -= Y_.leftCols(L) * c_;
+            u_.noalias() += gamma_ * (S_.leftCols(L) * c_);
+        }
+        const f64 su = s.dot(u_);
+        if (!(std::abs(su) >= opt.tr.sr1_skip_tol * s.norm() * u_.norm())) return;
+
+        i32 j = 0;
+        if (len_ < m_) {
+            j = len_++;
+        } else {
+            j = head_; // drop oldest
+            head_ = (head_ + 1 == m_) ? 0 : head_ + 1;
+        }
+        S_.col(j) = s;
+        Y_.col(j) = y;
+        // Gram rows/cols of slot j (a stale (j, j) entry is fixed below)
+        for (i32 i = 0; i < L; i++) {
+            SS_(i, j) = SS_(j, i) = Sts_[i];
+            SY_(i, j) = Sty_[i];
+            SY_(j, i) = Yts_[i];
+            YY_(i, j) = YY_(j, i) = Yty_[i];
+        }
+        SS_(j, j) = ss;
+        SY_(j, j) = sy;
+        YY_(j, j) = yy;
+    }
+
+  private:
+    void reset(i32 n, i32 m) {
+        m_ = std::max(m, 0);
+        S_.resize(n, m_);
+        Y_.resize(n, m_);
+        u_.resize(n);
+        SS_.setZero(m_, m_);
+        SY_.setZero(m_, m_);
+        YY_.setZero(m_, m_);
+        clear();
+    }
+    void clear() {
+        len_ = 0;
+        head_ = 0;
+        r_ = 0;
+        Ninv_.resize(0, 0);
+        W_.resize(0, 0);
+    }
+
+    // time order of slot a (0 = oldest)
+    i32 age(i32 a) const { return (a - head_ + m_) % m_; }
+
+    // factor the compact model for the current pairs; a changed gamma can leave N
+    // nearly singular against older pairs, so those are dropped until it is not
+    void build(f64 cond_max) {
+        dirty_ = false;
+        while (len_ > 0) {
+            const i32 L = len_;
+            // D + L + L^T, slot-indexed
+            Lsym_.resize(L, L);
+            for (i32 a = 0; a < L; a++) {
+                for (i32 b = 0; b < L; b++) {
+                    Lsym_(a, b) = (age(a) >= age(b)) ? SY_(a, b) : SY_(b, a);
+                }
+            }
+            if (assemble(gamma_new_, cond_max)) {
+                gamma_ = gamma_new_;
+                return;
+            }
+            if (gamma_new_ != gamma_ && assemble(gamma_, cond_max)) return;
+            drop_oldest();
+        }
+        gamma_ = gamma_new_;
+        clear();
+    }
+
+    // remove the oldest pair; the rest move to slots [0, len_ - 1) in time order
+    void drop_oldest() {
+        const i32 L = len_;
+        const i32 k = (head_ + 1) % L; // slot of the second oldest pair
+        const auto reverse = [&](i32 lo, i32 hi) {
+            for (--hi; lo < hi; ++lo, --hi) {
+                S_.col(lo).swap(S_.col(hi));
+                Y_.col(lo).swap(Y_.col(hi));
+            }
+        };
+        reverse(0, k); // rotate columns left by k
+        reverse(k, L);
+        reverse(0, L);
+        const auto permute = [&](matXd& G) {
+            const matXd t = G.topLeftCorner(L, L);
+            for (i32 i = 0; i < L; i++) {
+                for (i32 j = 0; j < L; j++) G(i, j) = t((i + k) % L, (j + k) % L);
+            }
+        };
+        permute(SS_);
+        permute(SY_);
+        permute(YY_);
+        len_ = L - 1;
+        head_ = 0;
+    }
+
+    bool assemble(f64 gamma, f64 cond_max) {
+        const i32 L = len_;
+        const matXd N = Lsym_ - gamma * SS_.topLeftCorner(L, L);
+        eig_.compute(N);
+        const vecXd& theta = eig_.eigenvalues();
+        const f64 theta_max = theta.cwiseAbs().maxCoeff();
+        if (!(theta_max > 0.0) || !(cond_max * theta.cwiseAbs().minCoeff() > theta_max)) {
+            return false;
+        }
+        Ninv_.noalias()
+            = eig_.eigenvectors() * theta.cwiseInverse().asDiagonal()
+            * eig_.eigenvectors().transpose();
+
+        // \Psi^T \Psi = Y^T Y - gamma (S^T Y + Y^T S) + gamma^2 S^T S
+        const matXd sy = SY_.topLeftCorner(L, L);
+        const matXd PtP = YY_.topLeftCorner(L, L) - gamma * (sy + sy.transpose())
+                        + gamma * gamma * SS_.topLeftCorner(L, L);
+        eig_.compute(PtP);
+        const vecXd& d = eig_.eigenvalues(); // ascending
+        const f64 d_max = d.maxCoeff();
+        if (!(d_max > 0.0)) return false;
+        i32 first = 0;
+        while (first < L && !(d[first] > 1e-10 * d_max)) ++first;
+        const i32 r = L - first;
+        const vecXd d_sqrt = d.tail(r).cwiseSqrt();
+        const matXd VD = eig_.eigenvectors().rightCols(r) * d_sqrt.asDiagonal();
+        const matXd A = VD.transpose() * Ninv_ * VD;
+        const matXd Vs
+            = eig_.eigenvectors().rightCols(r) * d_sqrt.cwiseInverse().asDiagonal();
+        eig_.compute(A);
+        W_.noalias() = Vs * eig_.eigenvectors();
+        lam_ = eig_.eigenvalues().array() + gamma;
+        r_ = r;
+        if (!lam_.allFinite() || !W_.allFinite()) return false;
+        gpar_.resize(r);
+        a_.resize(r);
+        c_.resize(L);
+        return true;
+    }
+
+    // g_par = W^T \Psi^T g, ||g_perp||^2 = ||g||^2 - ||g_par||^2
+    void project(ecref<vecXd> g) {
+        gg_ = g.squaredNorm();
+        const i32 L = len_;
+        if (r_ == 0) {
+            gpar_.resize(0);
+            gperp2_ = gg_;
+            return;
+        }
+        Sts_.noalias() = Y_.leftCols(L).transpose() * g;
+        Sts_.noalias() -= gamma_ * (S_.leftCols(L).transpose() * g);
+        gpar_.noalias() = W_.transpose() * Sts_;
+        gperp2_ = std::max(gg_ - gpar_.squaredNorm(), 0.0);
+    }
+
+    matXd S_;   // n x m ring of steps (slots [0, len_) valid)
+    matXd Y_;   // n x m ring of gradient differences
+    matXd SS_;  // S^T S, slot-indexed
+    matXd SY_;  // SY_(a, b) = s_a^T y_b, slot-indexed
+    matXd YY_;  // Y^T Y, slot-indexed
+    matXd Lsym_; // D + L + L^T (symmetrized S^T Y in time order)
+    matXd Ninv_; // N^{-1} for the current gamma_
+    matXd W_;    // P_par = \Psi W_
+    vecXd lam_;  // eigenvalues of B on span(P_par)
+    vecXd gpar_; // P_par^T g
+    vecXd a_;    // P_par^T p
+    vecXd c_;    // m-vector scratch
+    vecXd Sts_, Yts_, Sty_, Yty_;
+    vecXd u_; // y - B s
+    eig::SelfAdjointEigenSolver<matXd> eig_;
+    f64 gamma_ = 1.0;     // B_0 = gamma I
+    f64 gamma_new_ = 1.0; // from the newest pair with s^T y > 0
+    f64 gg_ = 0.0;
+    f64 gperp2_ = 0.0;
+    i32 m_ = 0;
+    i32 len_ = 0;
+    i32 head_ = 0;
+    i32 r_ = 0;
+    bool dirty_ = false;
+};
+
+} // namespace sOPT
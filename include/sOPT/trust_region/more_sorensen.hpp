@@ -0,0 +1,156 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/vecdefs.hpp"
+#include "sOPT/trust_region/tr_step.hpp"
+
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+
+namespace sOPT {
+
+// More-Sorensen exact trust-region step (dense Hessian)
+// ref: nocedal2006numerical pp.83-91, more1983computing
+//
+// \begin{aligned}
+// (H + \lambda I) p(\lambda) &= -g, \quad H + \lambda I \succeq 0, \quad \lambda \ge 0 \\
+// \lambda_{+} &= \lambda + \left(\frac{\|p\|}{\|q\|}\right)^2 \frac{\|p\| - \Delta}{\Delta},
+//     \quad L q = p
+// \end{aligned}
+//
+// Newton's method on 1/||p(lambda)|| = 1/Delta, safeguarded in [lambda_L, lambda_U]
+// (Gershgorin/norm bounds, tightened by every factorization). Stops once
+// | ||p|| - Delta | <= ms_tol Delta, or at lambda = 0 with ||p|| <= Delta. Every
+// lambda reuses the same LLT storage, and H is evaluated once per new x. A re-solve
+// after a rejection starts from the previous lambda, which is a lower bound for the
+// smaller radius. In the hard case (||p|| < Delta with lambda > 0 near -lambda_min)
+// the step is completed to the boundary along the eigenvector of lambda_min.
+struct MoreSorensen {
+    template <typename OracleT>
+    detail::EvalStatus solve(
+        OracleT& oracle,
+        const Options& opt,
+        ecref<vecXd> x,
+        ecref<vecXd> g,
+        f64 delta,
+        bool new_x,
+        eref<vecXd> p,
+        TRStep& step
+    ) {
+        const i32 n = static_cast<i32>(g.size());
+        const f64 sigma = opt.tr.ms_tol;
+        step = TRStep{};
+        if (new_x) {
+            if (H_.rows() != n) {
+                H_.resize(n, n);
+                for (vecXd* v : {&q_, &Hp_}) v->resize(n);
+            }
+            const detail::EvalStatus hess_status = detail::eval_hess(oracle, x, H_);
+            if (hess_status != detail::EvalStatus::ok) return hess_status;
+            H_norm1_ = H_.cwiseAbs().colwise().sum().maxCoeff();
+            diag_min_ = H_.diagonal().minCoeff();
+            lambda_ = 0.0;
+            indefinite_ = (diag_min_ < 0.0);
+            eig_ready_ = false;
+        }
+
+        const f64 gnorm = g.norm();
+        f64 lam_lo = std::max({0.0, -diag_min_, gnorm / delta - H_norm1_});
+        f64 lam_hi = gnorm / delta + H_norm1_;
+        if (!new_x) lam_lo = std::max(lam_lo, lambda_); // radius shrank: lambda grows
+        const auto bisect = [&]() {
+            const f64 geo = std::sqrt(lam_lo * lam_hi);
+            return std::max(geo, lam_lo + 0.01 * (lam_hi - lam_lo));
+        };
+        f64 lam = (lam_lo == 0.0 || (!new_x && lam_lo == lambda_)) ? lam_lo : bisect();
+
+        bool have_p = false;
+        f64 pnorm = 0.0;
+        for (i32 it = 0; it < opt.tr.ms_max_iters; it++) {
+            ++step.inner_iters;
+            if (!factor(lam)) { // H + lambda I not SPD
+                indefinite_ = true;
+                lam_lo = std::max(lam_lo, lam);
+                lam = bisect();
+                continue;
+            }
+            p.noalias() = -g;
+            llt_.solveInPlace(p);
+            pnorm = p.norm();
+            have_p = true;
+            lambda_ = lam;
+
+            if (lam == 0.0 && pnorm <= delta) break;              // interior Newton step
+            if (std::abs(pnorm - delta) <= sigma * delta) break; // on the boundary
+            if (pnorm < delta) {
+                lam_hi = lam;
+            } else {
+                lam_lo = lam;
+            }
+            if (lam_hi - lam_lo <= 1e-14 * lam_hi) break; // hard case: lambda pinned
+
+            q_ = p;
+            llt_.matrixL().solveInPlace(q_);
+            const f64 ratio = pnorm / q_.norm();
+            f64 lam_next = lam + ratio * ratio * (pnorm - delta) / delta;
+            if (!(lam_next > lam_lo && lam_next < lam_hi)) lam_next = bisect();
+            lam = lam_next;
+        }
+
+        if (!have_p) { // H + lambda_U I is SPD unless H is non-finite
+            lambda_ = lam_hi;
+            if (!factor(lam_hi)) return detail::EvalStatus::eval_failed;
+            p.noalias() = -g;
+            llt_.solveInPlace(p);
+            pnorm = p.norm();
+        }
+        if (pnorm > (1.0 + sigma) * delta) { // iterations ran out left of the root
+            p *= delta / pnorm;
+        } else if (lambda_ > 0.0 && pnorm < (1.0 - sigma) * delta) {
+            // hard case: move to the boundary along the lambda_min eigenvector
+            if (!eig_ready_) {
+                eig_.compute(H_);
+                eig_ready_ = (eig_.info() == eig::Success);
+            }
+            if (eig_ready_ && eig_.eigenvalues()(0) < 0.0) {
+                q_ = eig_.eigenvectors().col(0);
+                if (p.dot(q_) < 0.0) q_ = -q_;
+                const f64 tau = tr_boundary_tau(pnorm * pnorm, p.dot(q_), 1.0, delta);
+                p.noalias() += tau * q_;
+            }
+        }
+        step.neg_curvature = indefinite_;
+
+        // pred = -(g^T p + 0.5 p^T H p)
+        Hp_.noalias() = H_ * p;
+        step.pred = -(g.dot(p) + 0.5 * p.dot(Hp_));
+        step.norm = p.norm();
+        step.on_boundary = (step.norm >= (1.0 - sigma) * delta);
+        return p.allFinite() ? detail::EvalStatus::ok : detail::EvalStatus::eval_failed;
+    }
+
+  private:
+    // factor H + lambda I = L L^T; the shifted matrix is written straight into the
+    // factor's storage, which is reused for every lambda
+    bool factor(f64 lambda) {
+        const i32 n = static_cast<i32>(H_.rows());
+        llt_.compute(H_ + lambda * matXd::Identity(n, n));
+        return llt_.info() == eig::Success;
+    }
+
+    matXd H_;                                // hessian at the current x
+    eig::LLT<matXd> llt_;                    // Cholesky factor of H + lambda I
+    eig::SelfAdjointEigenSolver<matXd> eig_; // hard case only
+    vecXd q_;                                // L^{-1} p, eigenvector
+    vecXd Hp_;                               // H p
+    f64 H_norm1_ = 0.0;                      // ||H||_1
+    f64 diag_min_ = 0.0;                     // min_i H_ii
+    f64 lambda_ = 0.0;                       // last SPD shift
+    bool indefinite_ = false;                // H is not SPD
+    bool eig_ready_ = false;
+};
+
+} // namespace sOPT
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/vecdefs.hpp"
+#include "sOPT/trust_region/tr_step.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sOPT {
+
+// Steihaug-Toint truncated CG for the trust-region subproblem
+// ref: nocedal2006numerical pp.171-172
+//
+// CG on H p = -g from p = 0, stopped at
+// - ||H p + g|| <= min(0.5, sqrt(||g||)) ||g||  (interior step),
+// - d^T H d <= 0: p + tau d on the boundary (negative curvature),
+// - ||p + a d|| >= delta: p + tau d on the boundary,
+// - tr.max_cg_iters (0 => n).
+// The CG iterates grow monotonically in norm, so the first boundary crossing is
+// the last useful point. H is touched only through oracle.try_hv; memory is O(n).
+struct SteihaugCG {
+    template <typename OracleT>
+    detail::EvalStatus solve(
+        OracleT& oracle,
+        const Options& opt,
+        ecref<vecXd> x,
+        ecref<vecXd> g,
+        f64 delta,
+        bool new_x,
+        eref<vecXd> p,
+        TRStep& step
+    ) {
+        (void)new_x; // nothing to refresh: Hv products are taken at x directly
+        const ParallelOptions& par = opt.parallel;
+        const i32 n = static_cast<i32>(g.size());
+        if (r_.size() != n) {
+            for (vecXd* v : {&r_, &d_, &Hd_, &Hp_}) {
+                v->resize(n);
+                detail::par_first_touch(*v, par);
+            }
+        }
+        const i32 max_iters = (opt.tr.max_cg_iters > 0) ? opt.tr.max_cg_iters : n;
+        const f64 gnorm = detail::par_norm(g, par);
+        const f64 tol = std::min(0.5, std::sqrt(gnorm)) * gnorm;
+
+        step = TRStep{};
+        p.setZero();
+        Hp_.setZero();
+        detail::par_scale(1.0, g, r_, par);
+        detail::par_scale(-1.0, g, d_, par);
+        f64 rr = gnorm * gnorm;
+        f64 pp = 0.0;
+
+        for (i32 j = 0; j < max_iters; j++) {
+            if (!oracle.try_hv(x, d_, Hd_)) {
+                return oracle.any_limit_reached() ? detail::EvalStatus::max_evals
+                                                  : detail::EvalStatus::eval_failed;
+            }
+            ++step.inner_iters;
+
+            const f64 dHd = detail::par_dot(d_, Hd_, par);
+            const f64 a = rr / dHd;
+            const f64 pd = detail::par_dot(p, d_, par);
+            const f64 dd = detail::par_squared_norm(d_, par);
+            if (!(dHd > 0.0) || pp + 2.0 * a * pd + a * a * dd >= delta * delta) {
+                // leave along d to the boundary
+                step.neg_curvature = !(dHd > 0.0);
+                const f64 tau = tr_boundary_tau(pp, pd, dd, delta);
+                detail::par_axpy(tau, d_, p, par);
+                detail::par_axpy(tau, Hd_, Hp_, par);
+                step.on_boundary = true;
+                break;
+            }
+
+            detail::par_axpy(a, d_, p, par);
+            detail::par_axpy(a, Hd_, Hp_, par);
+            detail::par_axpy(a, Hd_, r_, par);
+            pp = detail::par_squared_norm(p, par);
+
+            const f64 rr_next = detail::par_squared_norm(r_, par);
+            if (std::sqrt(rr_next) <= tol) break;
+            detail::par_lincomb(-1.0, r_, rr_next / rr, d_, d_, par);
+            rr = rr_next;
+        }
+
+        // pred = -(g^T p + 0.5 p^T H p)
+        step.pred = -(detail::par_dot(g, p, par) + 0.5 * detail::par_dot(p, Hp_, par));
+        step.norm = detail::par_norm(p, par);
+        return p.allFinite() ? detail::EvalStatus::ok : detail::EvalStatus::eval_failed;
+    }
+
+  private:
+    vecXd r_;  // residual H p + g
+    vecXd d_;  // CG direction
+    vecXd Hd_; // H d
+    vecXd Hp_; // H p (model value)
+};
+
+} // namespace sOPT
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/typedefs.hpp"
+#include "sOPT/core/vecdefs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace sOPT {
+
+// Outcome of one trust-region subproblem solve
+//   min_p m(p) = g^T p + 0.5 p^T H p   s.t. ||p|| <= delta
+struct TRStep {
+    f64 pred = 0.0;           // predicted reduction -m(p)
+    f64 norm = 0.0;           // ||p||
+    bool on_boundary = false; // ||p|| = delta (radius may grow)
+    bool neg_curvature = false;
+    i32 inner_iters = 0; // CG / lambda iterations spent in the solve
+};
+
+// tau >= 0 with ||z + tau d|| = delta, given ||z|| <= delta
+inline f64 tr_boundary_tau(f64 zz, f64 zd, f64 dd, f64 delta) {
+    const f64 c = std::max(delta * delta - zz, 0.0);
+    if (c == 0.0) return 0.0;
+    const f64 disc = std::sqrt(zd * zd + dd * c);
+    return (zd >= 0.0) ? c / (zd + disc) : (disc - zd) / dd; // no cancellation
+}
+
+// subproblem solvers that learn from accepted steps (quasi-Newton models) provide
+//   void update(const Options& opt, ecref<vecXd> s, ecref<vecXd> y);
+template <typename T, typename = void>
+struct has_tr_update : std::false_type {};
+
+template <typename T>
+struct has_tr_update<T, std::void_t<decltype(std::declval<T&>().update(
+    std::declval<const Options&>(),
+    std::declval<ecref<vecXd>>(),
+    std::declval<ecref<vecXd>>()
+))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool has_tr_update_v = has_tr_update<T>::value;
+
+} // namespace sOPT
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "sOPT/algorithms/detail/solver_common.hpp"
+#include "sOPT/core/callback.hpp"
+#include "sOPT/core/math.hpp"
+#include "sOPT/core/options.hpp"
+#include "sOPT/core/parallel.hpp"
+#include "sOPT/core/result.hpp"
+#include "sOPT/problem/oracle.hpp"
+#include "sOPT/trust_region/dogleg.hpp"
+#include "sOPT/trust_region/lsr1.hpp"
+#include "sOPT/trust_region/more_sorensen.hpp"
+#include "sOPT/trust_region/steihaug_cg.hpp"
+#include "sOPT/trust_region/tr_step.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sOPT {
+// Trust-region method
+// ref: nocedal2006numerical pp.68-69
+//
+// \begin{aligned}
+// p_k &\approx \arg\min_{\|p\| \le \Delta_k} m_k(p) = f_k + g_k^T p + \tfrac12 p^T H_k p \\
+// \rho_k &= \frac{f(x_k) - f(x_k + p_k)}{m_k(0) - m_k(p_k)}
+// \end{aligned}
+//
+// x_{k+1} = x_k + p_k if \rho_k > eta_accept, otherwise the step is rejected and
+// the subproblem is re-solved at the same x_k with the smaller radius.
+// \Delta <- shrink ||p_k|| if \rho_k < eta_shrink, \Delta <- min(expand \Delta,
+// delta_max) if \rho_k > eta_expand and p_k hit the boundary. A non-finite trial
+// f counts as \rho_k = -\infty.
+//
+// The subproblem solver is a policy object (like a StepStrategy) with
+//   detail::EvalStatus solve(oracle, opt, x, g, delta, new_x, p, TRStep&)
+// where new_x is false for re-solves after a rejection (same x, g, H). It is
+// copied once per solve and may keep workspace/factorizations between calls. Solvers
+// with has_tr_update_v receive (p_k, g(x_k + p_k) - g_k) after every trial step,
+// rejected ones included (one extra gradient each), so a model that mispredicted
+// is corrected before the re-solve.
+namespace detail {
+template <typename Obj, typename Subproblem>
+Result trust_region_impl(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const Subproblem& subproblem,
+    const IterCallback& on_iter,
+    const StopCallback& should_stop
+) {
+    Oracle<Obj> oracle(obj, opt);
+    Result res;
+
+    const i32 n = static_cast<i32>(x0.size());
+    const ParallelOptions& par = opt.parallel;
+    const TrustRegionOptions& tr = opt.tr;
+    Subproblem sub(subproblem);
+    vecXd g(n); // gradient
+    vecXd p(n); // trust-region step
+    vecXd x_next(n);
+    vecXd y; // g_{k+1} - g_k for has_tr_update_v
+    if constexpr (has_tr_update_v<Subproblem>) y.resize(n);
+    for (vecXd* v : {&g, &p, &x_next, &y}) detail::par_first_touch(*v, par);
+    f64 f = 0.0;
+    f64 f_next = 0.0;
+    f64 delta = tr.delta0;
+    detail::TerminationScales term_scales;
+
+    if (auto st = detail::init_common(
+            oracle,
+            opt,
+            x0,
+            res,
+            g,
+            f,
+            on_iter,
+            should_stop,
+            &term_scales
+        )) {
+        res.status = *st;
+        detail::finalize_common(res, oracle, f, g.norm());
+        return res;
+    }
+
+    for (i32 k = 0; k < opt.term.max_iters; k++) {
+        const f64 gnorm = detail::par_norm(g, par);
+
+        if (auto st = detail::pre_step_checks(f, gnorm, opt, &term_scales)) {
+            res.status = *st;
+            break;
+        } // end prechecks
+
+        // trial steps at x_k until one is accepted
+        bool accepted = false;
+        bool new_x = true;
+        TRStep step;
+        while (!accepted) {
+            const EvalStatus sub_status
+                = sub.solve(oracle, opt, res.x, g, delta, new_x, p, step);
+            new_x = false;
+            if (sub_status != EvalStatus::ok) {
+                res.status = to_status(sub_status);
+                break;
+            }
+            res.cg_iters += step.inner_iters;
+            if (step.neg_curvature) ++res.neg_curvature;
+
+            detail::par_lincomb(1.0, res.x, 1.0, p, x_next, par);
+            const EvalStatus f_status = eval_func(oracle, x_next, f_next);
+            if (f_status == EvalStatus::max_evals) {
+                res.status = Status::max_evals;
+                break;
+            }
+
+            f64 rho = -std::numeric_limits<f64>::infinity();
+            if (f_status == EvalStatus::ok && step.pred > 0.0) {
+                // both reductions at roundoff level of f: trust the model
+                const f64 f_round = 10.0 * std::numeric_limits<f64>::epsilon()
+                                  * std::max(1.0, std::abs(f));
+                const f64 ared = f - f_next;
+                rho = (std::abs(ared) <= f_round && step.pred <= f_round)
+                        ? 1.0
+                        : ared / step.pred;
+            }
+
+            if (rho < tr.eta_shrink) {
+                delta = tr.shrink * std::min(delta, step.norm);
+            } else if (rho > tr.eta_expand && step.on_boundary) {
+                delta = std::min(tr.expand * delta, tr.delta_max);
+            }
+
+            if (rho > tr.eta_accept) {
+                accepted = true;
+            } else {
+                ++res.tr_rejected;
+                if constexpr (has_tr_update_v<Subproblem>) {
+                    // a rejected step still measures curvature along p
+                    if (f_status == EvalStatus::ok) {
+                        const EvalStatus g_status = eval_grad(oracle, x_next, y);
+                        if (g_status == EvalStatus::max_evals) {
+                            res.status = Status::max_evals;
+                            break;
+                        }
+                        if (g_status == EvalStatus::ok) {
+                            detail::par_lincomb(1.0, y, -1.0, g, y, par);
+                            sub.update(opt, p, y);
+                        }
+                    }
+                }
+                // no trial step can pass the step tolerance test any more
+                const f64 x_scale = std::max(1.0, detail::par_norm(res.x, par));
+                const f64 delta_min = std::max(
+                    step_tol_effective(opt, &term_scales),
+                    std::numeric_limits<f64>::epsilon() * x_scale
+                );
+                if (!(delta > delta_min)) {
+                    res.status = Status::converged_step;
+                    break;
+                }
+            }
+        } // end trial steps
+        if (!accepted) break;
+
+        IterDiagnostics diag;
+        if (opt.diag.enabled && opt.diag.record_directional_derivative) {
+            diag.gTp = detail::par_dot(g, p, par);
+        }
+
+        const f64 f_prev = f;
+        if constexpr (has_tr_update_v<Subproblem>) detail::par_scale(1.0, g, y, par);
+        if (auto st = detail::post_accept_with_step_status(
+                oracle,
+                opt,
+                res,
+                res.x,
+                f,
+                g,
+                x_next,
+                f_next,
+                f_prev,
+                1.0,
+                step.norm,
+                diag,
+                on_iter,
+                should_stop,
+                &term_scales
+            )) {
+            res.status = *st;
+            break;
+        }
+        if constexpr (has_tr_update_v<Subproblem>) { // s_k = p (alpha = 1)
+            detail::par_lincomb(1.0, g, -1.0, y, y, par);
+            sub.update(opt, p, y);
+        }
+    } // end iteration
+    detail::finalize_common(res, oracle, f, g.norm());
+    return res;
+}
+} // namespace detail
+
+template <typename Obj, typename Subproblem>
+Result trust_region(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const Subproblem& subproblem,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return detail::trust_region_impl(obj, x0, opt, subproblem, on_iter, should_stop);
+}
+
+// overload default Steihaug-CG
+template <typename Obj>
+Result trust_region(
+    const Obj& obj,
+    ecref<vecXd> x0,
+    const Options& opt,
+    const IterCallback& on_iter = {},
+    const StopCallback& should_stop = {}
+) {
+    return trust_region(obj, x0, opt, SteihaugCG{}, on_iter, should_stop);
+}
+
+} // namespace sOPT